@@ -806,10 +806,9 @@ class V8EXPORT String : public Primitive {
    * string buffer that resides outside V8's heap. Implement an
    * ExternalAsciiStringResource to manage the life cycle of the
    * underlying buffer.  Note that the string data must be immutable
-   * and that the data must be strict 7-bit ASCII, not Latin1 or
-   * UTF-8, which would require special treatment internally in the
-   * engine and, in the case of UTF-8, do not allow efficient indexing.
-   * Use String::New or convert to 16 bit data for non-ASCII.
+   * and that each byte is taken to be one Latin-1 character.  UTF-8
+   * does not allow efficient indexing; use String::New or convert to
+   * 16 bit data for characters outside Latin-1.
    */
 
   class V8EXPORT ExternalAsciiStringResource {  // NOLINT
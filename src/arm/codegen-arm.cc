@@ -122,9 +122,12 @@ CodeGenState::~CodeGenState() {
 // -------------------------------------------------------------------------
 // CodeGenerator implementation
 
-CodeGenerator::CodeGenerator(int buffer_size, Handle<Script> script,
-                             bool is_eval)
+CodeGenerator::CodeGenerator(int buffer_size,
+                             Handle<Script> script,
+                             bool is_eval,
+                             bool is_optimizing)
     : is_eval_(is_eval),
+      is_optimizing_(is_optimizing),
       script_(script),
       deferred_(8),
       masm_(new MacroAssembler(NULL, buffer_size)),
@@ -145,7 +145,8 @@ class CodeGenerator: public AstVisitor {
   // be called by compiler.cc.
   static Handle<Code> MakeCode(FunctionLiteral* fun,
                                Handle<Script> script,
-                               bool is_eval);
+                               bool is_eval,
+                               bool is_optimizing);
 
 #ifdef ENABLE_LOGGING_AND_PROFILING
   static bool ShouldGenerateLog(Expression* type);
@@ -190,7 +191,10 @@ class CodeGenerator: public AstVisitor {
 
  private:
   // Construction/Destruction
-  CodeGenerator(int buffer_size, Handle<Script> script, bool is_eval);
+  CodeGenerator(int buffer_size,
+                Handle<Script> script,
+                bool is_eval,
+                bool is_optimizing);
   virtual ~CodeGenerator() { delete masm_; }
 
   // Accessors
@@ -383,6 +387,7 @@ class CodeGenerator: public AstVisitor {
 #endif
 
   bool is_eval_;  // Tells whether code is generated for eval.
+  bool is_optimizing_;  // Tells whether a hot function is recompiled.
 
   Handle<Script> script_;
   List<DeferredCode*> deferred_;
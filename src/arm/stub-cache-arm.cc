@@ -44,6 +44,9 @@ static void ProbeTable(MacroAssembler* masm,
                        Register offset) {
   ExternalReference key_offset(SCTableReference::keyReference(table));
   ExternalReference value_offset(SCTableReference::valueReference(table));
+  StatsCounter* hit_counter = (table == StubCache::kPrimary)
+      ? &Counters::megamorphic_stub_cache_primary_hits
+      : &Counters::megamorphic_stub_cache_secondary_hits;
 
   Label miss;
 
@@ -65,6 +68,7 @@ static void ProbeTable(MacroAssembler* masm,
   __ and_(offset, offset, Operand(~Code::kFlagsNotUsedInLookup));
   __ cmp(offset, Operand(flags));
   __ b(ne, &miss);
+  __ IncrementCounter(hit_counter, 1, offset, ip);
 
   // Restore offset and re-load code entry from cache.
   __ pop(offset);
@@ -100,6 +104,12 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   ASSERT(!scratch.is(receiver));
   ASSERT(!scratch.is(name));
 
+  // The table sizes can change at runtime, so the masks are read from
+  // memory.
+  ExternalReference primary_mask(SCTableReference::maskReference(kPrimary));
+  ExternalReference secondary_mask(
+      SCTableReference::maskReference(kSecondary));
+
   // Check that the receiver isn't a smi.
   __ tst(receiver, Operand(kSmiTagMask));
   __ b(eq, &miss);
@@ -109,9 +119,9 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ ldr(ip, FieldMemOperand(receiver, HeapObject::kMapOffset));
   __ add(scratch, scratch, Operand(ip));
   __ eor(scratch, scratch, Operand(flags));
-  __ and_(scratch,
-          scratch,
-          Operand((kPrimaryTableSize - 1) << kHeapObjectTagSize));
+  __ mov(ip, Operand(primary_mask));
+  __ ldr(ip, MemOperand(ip));
+  __ and_(scratch, scratch, Operand(ip));
 
   // Probe the primary table.
   ProbeTable(masm, flags, kPrimary, name, scratch);
@@ -119,9 +129,9 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Primary miss: Compute hash for secondary probe.
   __ sub(scratch, scratch, Operand(name));
   __ add(scratch, scratch, Operand(flags));
-  __ and_(scratch,
-          scratch,
-          Operand((kSecondaryTableSize - 1) << kHeapObjectTagSize));
+  __ mov(ip, Operand(secondary_mask));
+  __ ldr(ip, MemOperand(ip));
+  __ and_(scratch, scratch, Operand(ip));
 
   // Probe the secondary table.
   ProbeTable(masm, flags, kSecondary, name, scratch);
@@ -129,6 +139,8 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(&Counters::megamorphic_stub_cache_misses, 1,
+                      scratch, ip);
 }
 
 
@@ -365,6 +377,27 @@ void StubCompiler::GenerateLoadMiss(MacroAssembler* masm, Code::Kind kind) {
 }
 
 
+void StubCompiler::GenerateMapDispatch(MacroAssembler* masm,
+                                       Register receiver,
+                                       Register scratch,
+                                       int count,
+                                       Map** maps,
+                                       Code** handlers,
+                                       Label* miss_label) {
+  // Check that the receiver isn't a smi.
+  __ tst(receiver, Operand(kSmiTagMask));
+  __ b(eq, miss_label);
+
+  // Jump to the handler for the receiver map.  The handlers expect the
+  // same state as the stub itself and check the map again.
+  __ ldr(scratch, FieldMemOperand(receiver, HeapObject::kMapOffset));
+  for (int i = 0; i < count; i++) {
+    __ cmp(scratch, Operand(Handle<Map>(maps[i])));
+    __ Jump(Handle<Code>(handlers[i]), RelocInfo::CODE_TARGET, eq);
+  }
+}
+
+
 #undef __
 #define __ ACCESS_MASM(masm())
 
@@ -809,6 +842,31 @@ Object* CallStubCompiler::CompileCallGlobal(JSObject* object,
 }
 
 
+Object* CallStubCompiler::CompileCallPolymorphic(int count,
+                                                 Map** maps,
+                                                 Code** handlers,
+                                                 String* name) {
+  // ----------- S t a t e -------------
+  //  -- lr: return address
+  // -----------------------------------
+  Label miss;
+
+  // Get the receiver from the stack.
+  const int argc = arguments().immediate();
+  __ ldr(r0, MemOperand(sp, argc * kPointerSize));
+
+  GenerateMapDispatch(masm(), r0, r3, count, maps, handlers, &miss);
+
+  // Handle call cache miss.
+  __ bind(&miss);
+  Handle<Code> ic = ComputeCallMiss(arguments().immediate());
+  __ Jump(ic, RelocInfo::CODE_TARGET);
+
+  // Return the generated code.
+  return GetPolymorphicCode(name);
+}
+
+
 Object* StoreStubCompiler::CompileStoreField(JSObject* object,
                                              int index,
                                              Map* transition,
@@ -1130,6 +1188,27 @@ Object* LoadStubCompiler::CompileLoadGlobal(JSObject* object,
 }
 
 
+Object* LoadStubCompiler::CompileLoadPolymorphic(int count,
+                                                 Map** maps,
+                                                 Code** handlers,
+                                                 String* name) {
+  // ----------- S t a t e -------------
+  //  -- r2    : name
+  //  -- lr    : return address
+  //  -- [sp]  : receiver
+  // -----------------------------------
+  Label miss;
+
+  __ ldr(r0, MemOperand(sp, 0));
+  GenerateMapDispatch(masm(), r0, r3, count, maps, handlers, &miss);
+  __ bind(&miss);
+  GenerateLoadMiss(masm(), Code::LOAD_IC);
+
+  // Return the generated code.
+  return GetPolymorphicCode(name);
+}
+
+
 Object* KeyedLoadStubCompiler::CompileLoadField(String* name,
                                                 JSObject* receiver,
                                                 JSObject* holder,
@@ -88,13 +88,20 @@ V(CHECK_REGISTER_EQ_POS, 43, 8) /* bc8 reg_idx24 addr32                     */ \
 V(CHECK_AT_START,    44, 8)   /* bc8 pad24 addr32                           */ \
 V(CHECK_NOT_AT_START, 45, 8)  /* bc8 pad24 addr32                           */ \
 V(CHECK_GREEDY,      46, 8)   /* bc8 pad24 addr32                           */ \
-V(ADVANCE_CP_AND_GOTO, 47, 8) /* bc8 offset24 addr32                        */
+V(ADVANCE_CP_AND_GOTO, 47, 8) /* bc8 offset24 addr32                        */ \
+V(LOAD_CHAR_CHECK_NOT_CHAR, 48, 12) /* bc8 offset24 addr32 uint32           */ \
+V(LOAD_CHAR_UNCHECKED_CHECK_CHAR, 49, 12) /* bc8 offset24 uint32 addr32     */ \
+V(LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR, 50, 12) /* bc8 offset24 uint32 addr32 */
 
 #define DECLARE_BYTECODES(name, code, length) \
   static const int BC_##name = code;
 BYTECODE_ITERATOR(DECLARE_BYTECODES)
 #undef DECLARE_BYTECODES
 
+#define COUNT_BYTECODES(name, code, length) + 1
+static const int kRegExpBytecodeCount = 0 BYTECODE_ITERATOR(COUNT_BYTECODES);
+#undef COUNT_BYTECODES
+
 #define DECLARE_BYTECODE_LENGTH(name, code, length) \
   static const int BC_##name##_LENGTH = length;
 BYTECODE_ITERATOR(DECLARE_BYTECODE_LENGTH)
@@ -130,7 +130,8 @@ void CodeGenerator::DeleteFrame() {
 // the compiler.cc code.
 Handle<Code> CodeGenerator::MakeCode(FunctionLiteral* flit,
                                      Handle<Script> script,
-                                     bool is_eval) {
+                                     bool is_eval,
+                                     bool is_optimizing) {
 #ifdef ENABLE_DISASSEMBLER
   bool print_code = Bootstrapper::IsActive()
       ? FLAG_print_builtin_code
@@ -169,7 +170,7 @@ Handle<Code> CodeGenerator::MakeCode(FunctionLiteral* flit,
 
   // Generate code.
   const int initial_buffer_size = 4 * KB;
-  CodeGenerator cgen(initial_buffer_size, script, is_eval);
+  CodeGenerator cgen(initial_buffer_size, script, is_eval, is_optimizing);
   CodeGeneratorScope scope(&cgen);
   cgen.GenCode(flit);
   if (cgen.HasStackOverflow()) {
@@ -293,7 +294,7 @@ Handle<JSFunction> CodeGenerator::BuildBoilerplate(FunctionLiteral* node) {
       return Handle<JSFunction>::null();
     }
 
-    code = MakeCode(node, script_, false);
+    code = MakeCode(node, script_, false, false);
 
     // Check for stack-overflow exception.
     if (code.is_null()) {
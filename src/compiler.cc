@@ -32,6 +32,7 @@
 #include "compilation-cache.h"
 #include "compiler.h"
 #include "debug.h"
+#include "ic.h"
 #include "oprofile-agent.h"
 #include "rewriter.h"
 #include "scopes.h"
@@ -43,7 +44,8 @@ namespace internal {
 static Handle<Code> MakeCode(FunctionLiteral* literal,
                              Handle<Script> script,
                              Handle<Context> context,
-                             bool is_eval) {
+                             bool is_eval,
+                             bool is_optimizing) {
   ASSERT(literal != NULL);
 
   // Rewrite the AST by introducing .result assignments where needed.
@@ -79,11 +81,104 @@ static Handle<Code> MakeCode(FunctionLiteral* literal,
   }
 
   // Generate code and return it.
-  Handle<Code> result = CodeGenerator::MakeCode(literal, script, is_eval);
+  Handle<Code> result =
+      CodeGenerator::MakeCode(literal, script, is_eval, is_optimizing);
   return result;
 }
 
 
+// Log the code generation for a function. If source information is
+// available include script name and line number. Check explicit whether
+// logging is enabled as finding the line number is not for free.
+static void LogFunctionCode(Handle<SharedFunctionInfo> shared,
+                            Handle<Code> code) {
+#if defined ENABLE_LOGGING_AND_PROFILING || defined ENABLE_OPROFILE_AGENT
+  if (Logger::is_logging() || OProfileAgent::is_enabled()) {
+    Handle<String> name(String::cast(shared->name()));
+    Handle<Script> script(Script::cast(shared->script()));
+    Handle<String> func_name(name->length() > 0 ?
+                             *name : shared->inferred_name());
+    if (script->name()->IsString()) {
+      int line_num =
+          GetScriptLineNumber(script, shared->start_position()) + 1;
+      LOG(CodeCreateEvent(Logger::LAZY_COMPILE_TAG, *code, *func_name,
+                          String::cast(script->name()), line_num));
+      OProfileAgent::CreateNativeCodeRegion(*func_name,
+                                            String::cast(script->name()),
+                                            line_num,
+                                            code->instruction_start(),
+                                            code->instruction_size());
+    } else {
+      LOG(CodeCreateEvent(Logger::LAZY_COMPILE_TAG, *code, *func_name));
+      OProfileAgent::CreateNativeCodeRegion(*func_name,
+                                            code->instruction_start(),
+                                            code->instruction_size());
+    }
+  }
+#endif
+}
+
+
+// Record the inobject fields loaded by the monomorphic named load
+// inline caches of a function's code.
+static void CollectLoadFeedback(Code* code,
+                                ZoneList<Handle<String> >* names,
+                                ZoneList<Handle<Map> >* maps,
+                                ZoneList<int>* offsets) {
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::CODE_TARGET);
+  for (RelocIterator it(code, mode_mask); !it.done(); it.next()) {
+    Code* target = Code::GetCodeFromTargetAddress(it.rinfo()->target_address());
+    String* name;
+    int offset;
+    PrintF("target kind %d state %d type %d\n", target->kind(), target->ic_state(), target->type());
+    Map* map = LoadIC::FindInobjectFieldLoad(target, &name, &offset);
+    if (map != NULL) {
+      names->Add(Handle<String>(name));
+      maps->Add(Handle<Map>(map));
+      offsets->Add(offset);
+    }
+  }
+}
+
+
+// Set up the inlined named loads of the optimized code of a function to
+// expect the receiver maps recorded for the same property names.  A
+// load that sees another map calls its inline cache, which repatches
+// it.  Returns the number of loads set up.
+static int ApplyLoadFeedback(Handle<Code> code,
+                             ZoneList<Handle<String> >* names,
+                             ZoneList<Handle<Map> >* maps,
+                             ZoneList<int>* offsets) {
+  if (names->is_empty()) return 0;
+  int patched = 0;
+  // The call to the inline cache of an inlined load is preceded by the
+  // load of the property name into a register.
+  String* name = NULL;
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT) |
+                  RelocInfo::ModeMask(RelocInfo::CODE_TARGET);
+  for (RelocIterator it(*code, mode_mask); !it.done(); it.next()) {
+    RelocInfo* info = it.rinfo();
+    if (info->rmode() == RelocInfo::EMBEDDED_OBJECT) {
+      Object* object = info->target_object();
+      name = object->IsString() ? String::cast(object) : NULL;
+      continue;
+    }
+    Code* target = Code::GetCodeFromTargetAddress(info->target_address());
+    if (name == NULL || target->kind() != Code::LOAD_IC) continue;
+    for (int i = 0; i < names->length(); i++) {
+      if (*names->at(i) == name) {
+        if (LoadIC::PatchInlinedLoad(info->pc(), *maps->at(i),
+                                     offsets->at(i))) {
+          patched++;
+        }
+        break;
+      }
+    }
+  }
+  return patched;
+}
+
+
 static bool IsValidJSON(FunctionLiteral* lit) {
   if (lit->body()->length() != 1)
     return false;
@@ -165,7 +260,7 @@ static Handle<JSFunction> MakeFunction(bool is_global,
   HistogramTimerScope timer(rate);
 
   // Compile the code.
-  Handle<Code> code = MakeCode(lit, script, context, is_eval);
+  Handle<Code> code = MakeCode(lit, script, context, is_eval, false);
 
   // Check for stack-overflow exceptions.
   if (code.is_null()) {
@@ -372,7 +467,8 @@ bool Compiler::CompileLazy(Handle<SharedFunctionInfo> shared,
   HistogramTimerScope timer(&Counters::compile_lazy);
 
   // Compile the code.
-  Handle<Code> code = MakeCode(lit, script, Handle<Context>::null(), false);
+  Handle<Code> code =
+      MakeCode(lit, script, Handle<Context>::null(), false, false);
 
   // Check for stack-overflow exception.
   if (code.is_null()) {
@@ -380,30 +476,7 @@ bool Compiler::CompileLazy(Handle<SharedFunctionInfo> shared,
     return false;
   }
 
-#if defined ENABLE_LOGGING_AND_PROFILING || defined ENABLE_OPROFILE_AGENT
-  // Log the code generation. If source information is available include script
-  // name and line number. Check explicit whether logging is enabled as finding
-  // the line number is not for free.
-  if (Logger::is_logging() || OProfileAgent::is_enabled()) {
-    Handle<String> func_name(name->length() > 0 ?
-                             *name : shared->inferred_name());
-    if (script->name()->IsString()) {
-      int line_num = GetScriptLineNumber(script, start_position) + 1;
-      LOG(CodeCreateEvent(Logger::LAZY_COMPILE_TAG, *code, *func_name,
-                          String::cast(script->name()), line_num));
-      OProfileAgent::CreateNativeCodeRegion(*func_name,
-                                            String::cast(script->name()),
-                                            line_num,
-                                            code->instruction_start(),
-                                            code->instruction_size());
-    } else {
-      LOG(CodeCreateEvent(Logger::LAZY_COMPILE_TAG, *code, *func_name));
-      OProfileAgent::CreateNativeCodeRegion(*func_name,
-                                            code->instruction_start(),
-                                            code->instruction_size());
-    }
-  }
-#endif
+  LogFunctionCode(shared, code);
 
   // Update the shared function info with the compiled code.
   shared->set_code(*code);
@@ -417,4 +490,67 @@ bool Compiler::CompileLazy(Handle<SharedFunctionInfo> shared,
 }
 
 
+bool Compiler::CompileOptimized(Handle<SharedFunctionInfo> shared) {
+  ASSERT(shared->is_compiled());
+  if (shared->code()->kind() != Code::FUNCTION) return false;
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  // Leave the code alone while the debugger has break points set or is
+  // stepping, as it keeps its own copy of the code of such functions.
+  if (Debug::has_break_points() || Debug::StepInActive() ||
+      Debug::InDebugger() || Debug::HasDebugInfo(shared)) {
+    return false;
+  }
+#endif
+
+  CompilationZoneScope zone_scope(DELETE_ON_EXIT);
+
+  // The VM is in the COMPILER state until exiting this function.
+  VMState state(COMPILER);
+
+  // Make sure we have an initial stack limit.
+  StackGuard guard;
+  PostponeInterruptsScope postpone;
+
+  // Collect the inline cache feedback first.  A full garbage collection
+  // during the compilation clears the inline caches.
+  ZoneList<Handle<String> > names(4);
+  ZoneList<Handle<Map> > maps(4);
+  ZoneList<int> offsets(4);
+  CollectLoadFeedback(shared->code(), &names, &maps, &offsets);
+
+  Handle<String> name(String::cast(shared->name()));
+  Handle<Script> script(Script::cast(shared->script()));
+  FunctionLiteral* lit = MakeLazyAST(script, name,
+                                     shared->start_position(),
+                                     shared->end_position(),
+                                     shared->is_expression());
+  if (lit == NULL) {
+    // The function parsed before, so this can only be a stack overflow.
+    Top::clear_pending_exception();
+    return false;
+  }
+
+  // Compile the whole function the way loop bodies are compiled.
+  lit->set_loop_nesting(1);
+
+  HistogramTimerScope timer(&Counters::compile_optimized);
+  Handle<Code> code =
+      MakeCode(lit, script, Handle<Context>::null(), false, true);
+  if (code.is_null()) return false;
+
+  int patched = ApplyLoadFeedback(code, &names, &maps, &offsets);
+  if (FLAG_trace_optimize) {
+    SmartPointer<char> function_name = name->length() > 0
+        ? name->ToCString()
+        : shared->inferred_name()->ToCString();
+    PrintF("[optimizing %s: %d of %d inlined loads set up from feedback]\n",
+           *function_name, patched, names.length());
+  }
+
+  LogFunctionCode(shared, code);
+  shared->set_code(*code);
+  return true;
+}
+
+
 } }  // namespace v8::internal
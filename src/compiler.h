@@ -71,6 +71,12 @@ class Compiler : public AllStatic {
   // true on success and false if the compilation resulted in a stack
   // overflow.
   static bool CompileLazy(Handle<SharedFunctionInfo> shared, int loop_nesting);
+
+  // Recompile a hot function with the optimizing code generator, using
+  // the feedback collected by the inline caches of its current code.
+  // Returns true if the function got new code.  Never raises an
+  // exception.
+  static bool CompileOptimized(Handle<SharedFunctionInfo> shared);
 };
 
 
@@ -31,7 +31,9 @@
 
 #include "conversions-inl.h"
 #include "factory.h"
+#include "fast-dtoa.h"
 #include "scanner.h"
+#include "strtod.h"
 
 namespace v8 {
 namespace internal {
@@ -48,7 +50,7 @@ int HexValue(uc32 c) {
 
 
 // Provide a common interface to getting a character at a certain
-// index from a char* or a String object.
+// index from a char*, a String object or a flat character vector.
 static inline int GetChar(const char* str, int index) {
   ASSERT(index >= 0 && index < static_cast<int>(strlen(str)));
   return str[index];
@@ -60,74 +62,49 @@ static inline int GetChar(String* str, int index) {
 }
 
 
-static inline int GetLength(const char* str) {
-  return strlen(str);
-}
-
-
-static inline int GetLength(String* str) {
-  return str->length();
-}
-
-
-static inline const char* GetCString(const char* str, int index) {
-  return str + index;
-}
-
-
-static inline const char* GetCString(String* str, int index) {
-  int length = str->length();
-  char* result = NewArray<char>(length + 1);
-  for (int i = index; i < length; i++) {
-    uc16 c = str->Get(i);
-    if (c <= 127) {
-      result[i - index] = static_cast<char>(c);
-    } else {
-      result[i - index] = 127;  // Force number parsing to fail.
-    }
-  }
-  result[length - index] = '\0';
-  return result;
+static inline int GetChar(Vector<const char>* str, int index) {
+  // The characters of ascii strings are Latin-1.
+  return static_cast<unsigned char>((*str)[index]);
 }
 
 
-static inline void ReleaseCString(const char* original, const char* str) {
+static inline int GetChar(Vector<const uc16>* str, int index) {
+  return (*str)[index];
 }
 
 
-static inline void ReleaseCString(String* original, const char* str) {
-  DeleteArray(const_cast<char *>(str));
+static inline int GetLength(const char* str) {
+  return strlen(str);
 }
 
 
-static inline bool IsSpace(const char* str, int index) {
-  ASSERT(index >= 0 && index < static_cast<int>(strlen(str)));
-  return Scanner::kIsWhiteSpace.get(str[index]);
+static inline int GetLength(String* str) {
+  return str->length();
 }
 
 
-static inline bool IsSpace(String* str, int index) {
-  return Scanner::kIsWhiteSpace.get(str->Get(index));
+template <typename Char>
+static inline int GetLength(Vector<const Char>* str) {
+  return str->length();
 }
 
 
-static inline bool SubStringEquals(const char* str,
-                                   int index,
-                                   const char* other) {
-  return strncmp(str + index, other, strlen(other)) != 0;
+template <class S>
+static inline bool IsSpace(S* str, int index) {
+  return Scanner::kIsWhiteSpace.get(GetChar(str, index));
 }
 
 
-static inline bool SubStringEquals(String* str, int index, const char* other) {
-  HandleScope scope;
-  int str_length = str->length();
-  int other_length = strlen(other);
-  int end = index + other_length < str_length ?
-            index + other_length :
-            str_length;
-  Handle<String> slice =
-      Factory::NewStringSlice(Handle<String>(str), index, end);
-  return slice->IsEqualTo(Vector<const char>(other, other_length));
+// Returns whether the characters of str starting at index are exactly
+// the characters of other.
+template <class S>
+static bool SubStringEquals(S* str, int index, const char* other) {
+  int length = GetLength(str);
+  for (int i = 0; other[i] != '\0'; i++) {
+    if (index + i >= length) return false;
+    if (GetChar(str, index + i) != other[i]) return false;
+  }
+  return true;
 }
 
 
@@ -163,9 +140,6 @@ static bool ShouldParseOctal(S* s, int i) {
 }
 
 
-extern "C" double gay_strtod(const char* s00, const char** se);
-
-
 // Parse an int from a string starting a given index and in a given
 // radix.  The string can be either a char* or a String*.
 template <class S>
@@ -232,15 +206,27 @@ static int InternalStringToInt(S* s, int i, int radix, double* value) {
   // code generation.  If the code generator spills the double value
   // it uses 64 bits and if it does not it uses 80 bits.
   //
-  // If there is a potential for overflow we resort to strtod for
+  // If there is a potential for overflow we resort to Strtod for
   // radix 10 numbers to get higher precision.  For numbers in another
   // radix we live with the loss of precision.
   static const double kPreciseConversionLimit = 9007199254740992.0;
   if (radix == 10 && v > kPreciseConversionLimit) {
-    const char* cstr = GetCString(s, i);
-    const char* end;
-    v = gay_strtod(cstr, &end);
-    ReleaseCString(s, cstr);
+    char buffer[kMaxSignificantDecimalDigits];
+    int buffer_pos = 0;
+    int exponent = 0;
+    int k = i;
+    while (k < j && GetChar(s, k) == '0') k++;
+    for (; k < j; k++) {
+      if (buffer_pos < kMaxSignificantDecimalDigits) {
+        buffer[buffer_pos++] = GetChar(s, k);
+      } else {
+        // Strtod ignores the digits beyond its limit anyway, except for
+        // forcing the last one to be non-zero.
+        if (GetChar(s, k) != '0') buffer[buffer_pos - 1] = '1';
+        exponent++;
+      }
+    }
+    v = Strtod(Vector<const char>(buffer, buffer_pos), exponent);
   }
 
   *value = v;
@@ -249,6 +235,15 @@ static int InternalStringToInt(S* s, int i, int radix, double* value) {
 
 
 int StringToInt(String* str, int index, int radix, double* value) {
+  if (str->IsFlat()) {
+    if (str->IsAsciiRepresentation()) {
+      Vector<const char> vector = str->ToAsciiVector();
+      return InternalStringToInt(&vector, index, radix, value);
+    } else {
+      Vector<const uc16> vector = str->ToUC16Vector();
+      return InternalStringToInt(&vector, index, radix, value);
+    }
+  }
   return InternalStringToInt(str, index, radix, value);
 }
 
@@ -261,6 +256,98 @@ int StringToInt(const char* str, int index, int radix, double* value) {
 static const double JUNK_STRING_VALUE = OS::nan_value();
 
 
+// Parses the unsigned decimal literal (ECMA-262 9.3.1) starting at index
+// and stores its value in result.  The significant digits are collected
+// directly from the string and converted by Strtod, so no C string copy of
+// the input is needed.  Returns the index of the first character after the
+// literal, or -1 if there is no literal at index.
+template <class S>
+static int InternalStringToDecimal(S* str, int index, double* result) {
+  int len = GetLength(str);
+  char buffer[kMaxSignificantDecimalDigits];
+  int buffer_pos = 0;
+  int exponent = 0;
+  bool digits_seen = false;
+  bool nonzero_digit_dropped = false;
+
+  // Leading zeros are not significant.
+  while (index < len && GetChar(str, index) == '0') {
+    index++;
+    digits_seen = true;
+  }
+  while (index < len && IsDecimalDigit(GetChar(str, index))) {
+    int c = GetChar(str, index++);
+    digits_seen = true;
+    if (buffer_pos < kMaxSignificantDecimalDigits) {
+      buffer[buffer_pos++] = c;
+    } else {
+      exponent++;
+      if (c != '0') nonzero_digit_dropped = true;
+    }
+  }
+
+  if (index < len && GetChar(str, index) == '.') {
+    index++;
+    if (buffer_pos == 0) {
+      // Zeros right after the point only move the decimal exponent.
+      while (index < len && GetChar(str, index) == '0') {
+        index++;
+        exponent--;
+        digits_seen = true;
+      }
+    }
+    while (index < len && IsDecimalDigit(GetChar(str, index))) {
+      int c = GetChar(str, index++);
+      digits_seen = true;
+      if (buffer_pos < kMaxSignificantDecimalDigits) {
+        buffer[buffer_pos++] = c;
+        exponent--;
+      } else if (c != '0') {
+        nonzero_digit_dropped = true;
+      }
+    }
+  }
+
+  // A lone '.' or sign is not a number.
+  if (!digits_seen) return -1;
+
+  // The exponent part only belongs to the number if it has digits.
+  if (index < len &&
+      (GetChar(str, index) == 'e' || GetChar(str, index) == 'E')) {
+    int exponent_index = index + 1;
+    int exponent_sign = 1;
+    if (exponent_index < len) {
+      int c = GetChar(str, exponent_index);
+      if (c == '+' || c == '-') {
+        if (c == '-') exponent_sign = -1;
+        exponent_index++;
+      }
+    }
+    if (exponent_index < len && IsDecimalDigit(GetChar(str, exponent_index))) {
+      // Exponents this large overflow to infinity or zero anyway; clamping
+      // keeps the arithmetic below from overflowing.
+      static const int kMaxExponentValue = 100000000;
+      int value = 0;
+      while (exponent_index < len &&
+             IsDecimalDigit(GetChar(str, exponent_index))) {
+        if (value < kMaxExponentValue) {
+          value = value * 10 + GetChar(str, exponent_index) - '0';
+        }
+        exponent_index++;
+      }
+      exponent += exponent_sign * value;
+      index = exponent_index;
+    }
+  }
+
+  if (nonzero_digit_dropped) buffer[buffer_pos - 1] = '1';
+  *result = (buffer_pos == 0)
+      ? 0.0
+      : Strtod(Vector<const char>(buffer, buffer_pos), exponent);
+  return index;
+}
+
+
 // Convert a string to a double value.  The string can be either a
 // char* or a String*.
 template<class S>
@@ -303,32 +390,26 @@ static double InternalStringToDouble(S* str,
       GetChar(str, index) == '0' &&
       (GetChar(str, index + 1) == 'x' || GetChar(str, index + 1) == 'X')) {
     index += 2;
-    index = StringToInt(str, index, 16, &result);
+    index = InternalStringToInt(str, index, 16, &result);
   } else if ((flags & ALLOW_OCTALS) != 0 && ShouldParseOctal(str, index)) {
     // NOTE: We optimistically try to parse the number as an octal (if
     // we're allowed to), even though this is not as dictated by
     // ECMA-262. The reason for doing this is compatibility with IE and
     // Firefox.
-    index = StringToInt(str, index, 8, &result);
+    index = InternalStringToInt(str, index, 8, &result);
   } else {
-    const char* cstr = GetCString(str, index);
-    const char* end;
-    // Optimistically parse the number and then, if that fails,
-    // check if it might have been {+,-,}Infinity.
-    result = gay_strtod(cstr, &end);
-    ReleaseCString(str, cstr);
-    if (result != 0.0 || end != cstr) {
-      // It appears that strtod worked
-      index += end - cstr;
-    } else {
-      // Check for {+,-,}Infinity
-      bool is_negative = (GetChar(str, index) == '-');
-      if (GetChar(str, index) == '+' || GetChar(str, index) == '-')
-        index++;
-      if (!SubStringEquals(str, index, "Infinity"))
-        return JUNK_STRING_VALUE;
-      result = is_negative ? -V8_INFINITY : V8_INFINITY;
+    // A '-' sign has been consumed above; a '+' is only allowed instead.
+    if (sign == 1 && GetChar(str, index) == '+') {
+      index++;
+      if (index == len) return JUNK_STRING_VALUE;
+    }
+    if (GetChar(str, index) == 'I') {
+      if (!SubStringEquals(str, index, "Infinity")) return JUNK_STRING_VALUE;
+      result = V8_INFINITY;
       index += 8;
+    } else {
+      index = InternalStringToDecimal(str, index, &result);
+      if (index < 0) return JUNK_STRING_VALUE;
     }
   }
 
@@ -344,6 +425,15 @@ static double InternalStringToDouble(S* str,
 
 
 double StringToDouble(String* str, int flags, double empty_string_val) {
+  if (str->IsFlat()) {
+    if (str->IsAsciiRepresentation()) {
+      Vector<const char> vector = str->ToAsciiVector();
+      return InternalStringToDouble(&vector, flags, empty_string_val);
+    } else {
+      Vector<const uc16> vector = str->ToUC16Vector();
+      return InternalStringToDouble(&vector, flags, empty_string_val);
+    }
+  }
   return InternalStringToDouble(str, flags, empty_string_val);
 }
 
@@ -358,6 +448,47 @@ extern "C" char* dtoa(double d, int mode, int ndigits,
 
 extern "C" void freedtoa(char* s);
 
+
+// The largest number of significant digits requested by toPrecision and
+// toExponential, plus one for the terminating '\0'.
+static const int kMaxDigitsBufferSize = 22;
+
+
+// Computes the decimal digits of the strictly positive, finite value v and
+// stores them null-terminated in buffer, such that v is approximately
+// 0.buffer * 10^decimal_point.  In FAST_DTOA_SHORTEST mode the digits are
+// the shortest ones that read back as v (dtoa mode 0); in
+// FAST_DTOA_PRECISION mode they are the requested_digits most significant
+// digits, correctly rounded and without trailing zeros (dtoa mode 2).  The
+// fast Grisu3 algorithm is tried first and the bignum based dtoa is used
+// only for the inputs it cannot decide.
+static void DoubleToDigits(double v,
+                           FastDtoaMode mode,
+                           int requested_digits,
+                           Vector<char> buffer,
+                           int* length,
+                           int* decimal_point) {
+  ASSERT(v > 0);
+  ASSERT(mode == FAST_DTOA_SHORTEST || requested_digits < buffer.length());
+  if (FastDtoa(v, mode, requested_digits, buffer, length, decimal_point)) {
+    Counters::fast_dtoa_hits.Increment();
+    // Strip the trailing zeros the counted version keeps.
+    while (*length > 1 && buffer[*length - 1] == '0') (*length)--;
+    buffer[*length] = '\0';
+    return;
+  }
+  Counters::fast_dtoa_misses.Increment();
+  int sign;
+  char* decimal_rep = (mode == FAST_DTOA_SHORTEST)
+      ? dtoa(v, 0, 0, decimal_point, &sign, NULL)
+      : dtoa(v, 2, requested_digits, decimal_point, &sign, NULL);
+  *length = strlen(decimal_rep);
+  ASSERT(*length < buffer.length());
+  memcpy(buffer.start(), decimal_rep, *length + 1);
+  freedtoa(decimal_rep);
+}
+
+
 const char* DoubleToCString(double v, Vector<char> buffer) {
   StringBuilder builder(buffer.start(), buffer.length());
 
@@ -380,36 +511,41 @@ const char* DoubleToCString(double v, Vector<char> buffer) {
 
     default: {
       int decimal_point;
-      int sign;
-
-      char* decimal_rep = dtoa(v, 0, 0, &decimal_point, &sign, NULL);
-      int length = strlen(decimal_rep);
-
-      if (sign) builder.AddCharacter('-');
+      int length;
+      char decimal_rep_buffer[kFastDtoaMaximalLength + 1];
+      Vector<char> decimal_rep(decimal_rep_buffer,
+                               ARRAY_SIZE(decimal_rep_buffer));
+
+      if (v < 0) {
+        builder.AddCharacter('-');
+        v = -v;
+      }
+      DoubleToDigits(v, FAST_DTOA_SHORTEST, 0,
+                     decimal_rep, &length, &decimal_point);
 
       if (length <= decimal_point && decimal_point <= 21) {
         // ECMA-262 section 9.8.1 step 6.
-        builder.AddString(decimal_rep);
+        builder.AddString(decimal_rep.start());
         builder.AddPadding('0', decimal_point - length);
 
       } else if (0 < decimal_point && decimal_point <= 21) {
         // ECMA-262 section 9.8.1 step 7.
-        builder.AddSubstring(decimal_rep, decimal_point);
+        builder.AddSubstring(decimal_rep.start(), decimal_point);
         builder.AddCharacter('.');
-        builder.AddString(decimal_rep + decimal_point);
+        builder.AddString(decimal_rep.start() + decimal_point);
 
       } else if (decimal_point <= 0 && decimal_point > -6) {
         // ECMA-262 section 9.8.1 step 8.
         builder.AddString("0.");
         builder.AddPadding('0', -decimal_point);
-        builder.AddString(decimal_rep);
+        builder.AddString(decimal_rep.start());
 
       } else {
         // ECMA-262 section 9.8.1 step 9 and 10 combined.
         builder.AddCharacter(decimal_rep[0]);
         if (length != 1) {
           builder.AddCharacter('.');
-          builder.AddString(decimal_rep + 1);
+          builder.AddString(decimal_rep.start() + 1);
         }
         builder.AddCharacter('e');
         builder.AddCharacter((decimal_point >= 0) ? '+' : '-');
@@ -417,8 +553,6 @@ const char* DoubleToCString(double v, Vector<char> buffer) {
         if (exponent < 0) exponent = -exponent;
         builder.AddFormatted("%d", exponent);
       }
-
-      freedtoa(decimal_rep);
     }
   }
   return builder.Finalize();
@@ -547,28 +681,36 @@ char* DoubleToExponentialCString(double value, int f) {
     negative = true;
   }
 
+  // Zero has no significant digits; it is handled separately since the
+  // digit generation requires a positive input.
+  if (value == 0) {
+    char zero[] = "0";
+    int significant_digits = (f == -1) ? 1 : f + 1;
+    return CreateExponentialRepresentation(zero, 0, negative,
+                                           significant_digits);
+  }
+
   // Find a sufficiently precise decimal representation of n.
   int decimal_point;
-  int sign;
-  char* decimal_rep = NULL;
+  int decimal_rep_length;
+  char decimal_rep_buffer[kMaxDigitsBufferSize];
+  Vector<char> decimal_rep(decimal_rep_buffer, kMaxDigitsBufferSize);
   if (f == -1) {
-    decimal_rep = dtoa(value, 0, 0, &decimal_point, &sign, NULL);
-    f = strlen(decimal_rep) - 1;
+    DoubleToDigits(value, FAST_DTOA_SHORTEST, 0,
+                   decimal_rep, &decimal_rep_length, &decimal_point);
+    f = decimal_rep_length - 1;
   } else {
-    decimal_rep = dtoa(value, 2, f + 1, &decimal_point, &sign, NULL);
+    DoubleToDigits(value, FAST_DTOA_PRECISION, f + 1,
+                   decimal_rep, &decimal_rep_length, &decimal_point);
   }
-  int decimal_rep_length = strlen(decimal_rep);
   ASSERT(decimal_rep_length > 0);
   ASSERT(decimal_rep_length <= f + 1);
-  USE(decimal_rep_length);
 
   int exponent = decimal_point - 1;
-  char* result =
-      CreateExponentialRepresentation(decimal_rep, exponent, negative, f+1);
-
-  freedtoa(decimal_rep);
-
-  return result;
+  return CreateExponentialRepresentation(decimal_rep.start(),
+                                         exponent,
+                                         negative,
+                                         f + 1);
 }
 
 
@@ -583,9 +725,20 @@ char* DoubleToPrecisionCString(double value, int p) {
 
   // Find a sufficiently precise decimal representation of n.
   int decimal_point;
-  int sign;
-  char* decimal_rep = dtoa(value, 2, p, &decimal_point, &sign, NULL);
-  int decimal_rep_length = strlen(decimal_rep);
+  int decimal_rep_length;
+  char decimal_rep_buffer[kMaxDigitsBufferSize];
+  Vector<char> decimal_rep_vector(decimal_rep_buffer, kMaxDigitsBufferSize);
+  if (value == 0) {
+    // Zero is formatted the way dtoa represents it.
+    decimal_rep_buffer[0] = '0';
+    decimal_rep_buffer[1] = '\0';
+    decimal_rep_length = 1;
+    decimal_point = 1;
+  } else {
+    DoubleToDigits(value, FAST_DTOA_PRECISION, p,
+                   decimal_rep_vector, &decimal_rep_length, &decimal_point);
+  }
+  char* decimal_rep = decimal_rep_buffer;
   ASSERT(decimal_rep_length <= p);
 
   int exponent = decimal_point - 1;
@@ -629,7 +782,6 @@ char* DoubleToPrecisionCString(double value, int p) {
     result = builder.Finalize();
   }
 
-  freedtoa(decimal_rep);
   return result;
 }
 
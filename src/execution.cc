@@ -307,6 +307,12 @@ bool StackGuard::IsSet(const ExecutionAccess& lock) {
 }
 
 
+bool StackGuard::HasPendingInterrupts() {
+  ExecutionAccess access;
+  return IsSet(access);
+}
+
+
 bool StackGuard::IsInterrupted() {
   ExecutionAccess access;
   return thread_local_.interrupt_flags_ & INTERRUPT;
@@ -160,6 +160,9 @@ class StackGuard BASE_EMBEDDED {
   static int ArchiveSpacePerThread();
 
   static bool IsStackOverflow();
+  // Returns true if any interrupt has been requested.  Code that does not
+  // check the stack limit can poll this instead.
+  static bool HasPendingInterrupts();
   static bool IsPreempted();
   static void Preempt();
   static bool IsInterrupted();
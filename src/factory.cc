@@ -910,6 +910,9 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpMaxRegisterCountIndex, Smi::FromInt(0));
   store->set(JSRegExp::kIrregexpCaptureCountIndex,
              Smi::FromInt(capture_count));
+  store->set(JSRegExp::kIrregexpLiteralIndex, Heap::undefined_value());
+  store->set(JSRegExp::kIrregexpLiteralMinOffsetIndex, Smi::FromInt(0));
+  store->set(JSRegExp::kIrregexpLiteralMaxOffsetIndex, Smi::FromInt(0));
   regexp->set_data(*store);
 }
 
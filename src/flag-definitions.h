@@ -133,6 +133,11 @@ DEFINE_bool(debug_info, true, "add debug information to compiled functions")
 DEFINE_bool(strict, false, "strict error checking")
 DEFINE_int(min_preparse_length, 1024,
            "Minimum length for automatic enable preparsing")
+DEFINE_bool(optimize_hot_functions, true,
+            "recompile hot functions using inline cache feedback")
+DEFINE_int(hot_function_threshold, 1000,
+           "calls and loop iterations before a function is recompiled")
+DEFINE_bool(trace_optimize, false, "trace recompilation of hot functions")
 
 // compilation-cache.cc
 DEFINE_bool(compilation_cache, true, "enable compilation cache")
@@ -173,6 +178,8 @@ DEFINE_bool(cleanup_ics_at_gc, true,
             "Flush inline caches prior to mark compact collection.")
 DEFINE_bool(cleanup_caches_in_maps_at_gc, true,
             "Flush code caches in maps during mark compact cycle.")
+DEFINE_bool(trim_sliced_strings, true,
+            "Copy sliced strings whose buffer is otherwise dead at full GC.")
 
 DEFINE_bool(canonicalize_object_literal_maps, true,
             "Canonicalize maps for object literals.")
@@ -190,6 +197,12 @@ DEFINE_bool(optimize_ast, true, "optimize the ast")
 DEFINE_bool(trace_sim, false, "trace simulator execution")
 DEFINE_int(stop_sim_at, 0, "Simulator stop after x number of instructions")
 
+// stub-cache.cc
+DEFINE_int(stub_cache_size, 2048,
+           "initial number of entries in the primary stub cache table")
+DEFINE_bool(grow_stub_cache, true,
+            "grow the stub cache at full GCs if it overflowed often")
+
 // top.cc
 DEFINE_bool(trace_exception, false,
             "print stack trace when throwing exceptions")
@@ -206,6 +219,10 @@ DEFINE_bool(preemption, false,
 // Regexp
 DEFINE_bool(trace_regexps, false, "trace regexp execution")
 DEFINE_bool(regexp_optimization, true, "generate optimized regexp code")
+DEFINE_int(regexp_backtrack_limit, 0,
+           "throw an exception from regexp matches that backtrack more than "
+           "this many times (0 for no limit; native code reads it when a "
+           "regexp is compiled)")
 
 // Testing flags test/cctest/test-{flags,api,serialization}.cc
 DEFINE_bool(testing_bool_flag, true, "testing_bool_flag")
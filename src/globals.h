@@ -89,6 +89,10 @@ typedef byte* Address;
 #define V8_PTR_PREFIX ""
 #endif  // V8_HOST_ARCH_64_BIT
 
+// Builds a 64-bit constant from its high and low 32-bit halves.  The low
+// half must be given as exactly eight hexadecimal digits without prefix.
+#define V8_2PART_UINT64_C(a, b) (((static_cast<uint64_t>(a) << 32) + 0x##b##u))
+
 #define V8PRIxPTR V8_PTR_PREFIX "x"
 #define V8PRIdPTR V8_PTR_PREFIX "d"
 
@@ -341,6 +345,8 @@ enum InlineCacheState {
   MONOMORPHIC,
   // Like MONOMORPHIC but check failed due to prototype.
   MONOMORPHIC_PROTOTYPE_FAILURE,
+  // Has been executed and a few receiver types have been seen.
+  POLYMORPHIC,
   // Multiple receiver types have been seen.
   MEGAMORPHIC,
   // Special states for debug break or step in prepare stubs.
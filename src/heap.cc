@@ -34,6 +34,7 @@
 #include "compilation-cache.h"
 #include "debug.h"
 #include "global-handles.h"
+#include "jsregexp.h"
 #include "mark-compact.h"
 #include "natives.h"
 #include "scanner.h"
@@ -473,6 +474,11 @@ void Heap::MarkCompact(GCTracer* tracer) {
 
   gc_state_ = NOT_IN_GC;
 
+  {
+    DisableAssertNoAllocation allow_allocation;
+    MarkCompactCollector::TrimSlicedStrings();
+  }
+
   Shrink();
 
   Counters::objs_since_last_full.Set(0);
@@ -488,6 +494,7 @@ void Heap::MarkCompactPrologue(bool is_compacting) {
   DescriptorLookupCache::Clear();
 
   CompilationCache::MarkCompactPrologue();
+  RegExpResultCache::Clear();
 
   Top::MarkCompactPrologue(is_compacting);
   ThreadManager::MarkCompactPrologue(is_compacting);
@@ -618,6 +625,9 @@ void Heap::Scavenge() {
   // Clear descriptor cache.
   DescriptorLookupCache::Clear();
 
+  // Clear regexp result cache.
+  RegExpResultCache::Clear();
+
   // Used for updating survived_since_last_expansion_ at function end.
   int survived_watermark = PromotedSpaceSize();
 
@@ -1461,6 +1471,9 @@ bool Heap::CreateInitialObjects() {
   // Initialize compilation cache.
   CompilationCache::Clear();
 
+  // Initialize regexp result cache.
+  RegExpResultCache::Clear();
+
   return true;
 }
 
@@ -1590,6 +1603,7 @@ Object* Heap::AllocateSharedFunctionInfo(Object* name) {
   share->set_start_position_and_type(0);
   share->set_debug_info(undefined_value());
   share->set_inferred_name(empty_string());
+  share->set_hotness_count(FLAG_hot_function_threshold);
   return result;
 }
 
@@ -1694,6 +1708,7 @@ Object* Heap::AllocateSlicedString(String* buffer,
   sliced_string->set_buffer(buffer);
   sliced_string->set_start(start);
   sliced_string->set_length(length);
+  Counters::sliced_strings_created.Increment();
 
   return result;
 }
@@ -1782,9 +1797,10 @@ Object* Heap::LookupSingleCharacterStringFromCode(uint16_t code) {
     Object* value = Heap::single_character_string_cache()->get(code);
     if (value != Heap::undefined_value()) return value;
 
-    char buffer[1];
-    buffer[0] = static_cast<char>(code);
-    Object* result = LookupSymbol(Vector<const char>(buffer, 1));
+    // Symbols are looked up by their UTF-8 encoding.
+    char buffer[unibrow::Utf8::kMaxEncodedSize];
+    int length = unibrow::Utf8::Encode(buffer, code);
+    Object* result = LookupSymbol(Vector<const char>(buffer, length));
 
     if (result->IsFailure()) return result;
     Heap::single_character_string_cache()->set(code, result);
@@ -2238,7 +2254,7 @@ Object* Heap::AllocateStringFromAscii(Vector<const char> string,
   // Copy the characters into the new object.
   SeqAsciiString* string_result = SeqAsciiString::cast(result);
   for (int i = 0; i < string.length(); i++) {
-    string_result->SeqAsciiStringSet(i, string[i]);
+    string_result->SeqAsciiStringSet(i, static_cast<byte>(string[i]));
   }
   return result;
 }
@@ -2247,22 +2263,26 @@ Object* Heap::AllocateStringFromAscii(Vector<const char> string,
 Object* Heap::AllocateStringFromUtf8(Vector<const char> string,
                                      PretenureFlag pretenure) {
   // Count the number of characters in the UTF-8 string and check if
-  // it is an ASCII string.
+  // it is a 7-bit ASCII or at least a Latin-1 string.
   Access<Scanner::Utf8Decoder> decoder(Scanner::utf8_decoder());
   decoder->Reset(string.start(), string.length());
   int chars = 0;
+  bool is_seven_bit = true;
   bool is_ascii = true;
   while (decoder->has_more()) {
     uc32 r = decoder->GetNext();
+    if (r > unibrow::Utf8::kMaxOneByteChar) is_seven_bit = false;
     if (r > String::kMaxAsciiCharCode) is_ascii = false;
     chars++;
   }
 
-  // If the string is ascii, we do not need to convert the characters
-  // since UTF8 is backwards compatible with ascii.
-  if (is_ascii) return AllocateStringFromAscii(string, pretenure);
+  // If the string is 7-bit ASCII, we do not need to convert the characters
+  // since UTF8 is backwards compatible with ASCII.
+  if (is_seven_bit) return AllocateStringFromAscii(string, pretenure);
 
-  Object* result = AllocateRawTwoByteString(chars, pretenure);
+  Object* result = is_ascii
+      ? AllocateRawAsciiString(chars, pretenure)
+      : AllocateRawTwoByteString(chars, pretenure);
   if (result->IsFailure()) return result;
 
   // Convert and copy the characters into the new object.
@@ -2376,7 +2396,7 @@ Object* Heap::AllocateInternalSymbol(unibrow::CharacterStream* buffer,
   // Determine whether the string is ascii.
   bool is_ascii = true;
   while (buffer->has_more() && is_ascii) {
-    if (buffer->GetNext() > unibrow::Utf8::kMaxOneByteChar) is_ascii = false;
+    if (buffer->GetNext() > String::kMaxAsciiCharCode) is_ascii = false;
   }
   buffer->Rewind();
 
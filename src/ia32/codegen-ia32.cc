@@ -104,8 +104,10 @@ CodeGenState::~CodeGenState() {
 
 CodeGenerator::CodeGenerator(int buffer_size,
                              Handle<Script> script,
-                             bool is_eval)
+                             bool is_eval,
+                             bool is_optimizing)
     : is_eval_(is_eval),
+      is_optimizing_(is_optimizing),
       script_(script),
       deferred_(8),
       masm_(new MacroAssembler(NULL, buffer_size)),
@@ -262,6 +264,7 @@ void CodeGenerator::GenCode(FunctionLiteral* fun) {
       // Ignore the return value.
     }
     CheckStack();
+    UpdateHotnessCount();
 
     // Compile the body of the function in a vanilla state. Don't
     // bother compiling all the code if the scope has an illegal
@@ -908,8 +911,11 @@ void CodeGenerator::GenericBinaryOperation(Token::Value op,
 
     default:
       // By default only inline the Smi check code for likely smis if this
-      // operation is part of a loop.
-      flags = ((loop_nesting() > 0) && type->IsLikelySmi())
+      // operation is part of a loop.  Hot functions recompiled by the
+      // optimizing compiler inline it for all operations; the stub is
+      // the fallback when the operands turn out not to be smis.
+      flags = ((loop_nesting() > 0) &&
+               (type->IsLikelySmi() || is_optimizing()))
               ? SMI_CODE_INLINED
               : SMI_CODE_IN_STUB;
       break;
@@ -2291,6 +2297,47 @@ void CodeGenerator::CheckStack() {
 }
 
 
+class DeferredHotnessCount: public DeferredCode {
+ public:
+  DeferredHotnessCount() {
+    set_comment("[ DeferredHotnessCount");
+  }
+
+  virtual void Generate();
+};
+
+
+void DeferredHotnessCount::Generate() {
+  __ push(Operand(ebp, JavaScriptFrameConstants::kFunctionOffset));
+  __ CallRuntime(Runtime::kOptimizeFunction, 1);
+}
+
+
+void CodeGenerator::UpdateHotnessCount() {
+  // Only functions in user scripts that can be compiled lazily can be
+  // parsed again by the optimizing compiler.
+  if (!FLAG_optimize_hot_functions ||
+      is_optimizing() ||
+      !scope_->is_function_scope() ||
+      !scope_->AllowsLazyCompilation() ||
+      Smi::cast(script_->type())->value() != Script::TYPE_NORMAL) {
+    return;
+  }
+  DeferredHotnessCount* deferred = new DeferredHotnessCount;
+  Result shared = allocator_->Allocate();
+  ASSERT(shared.is_valid());
+  __ mov(shared.reg(),
+         Operand(ebp, JavaScriptFrameConstants::kFunctionOffset));
+  __ mov(shared.reg(),
+         FieldOperand(shared.reg(), JSFunction::kSharedFunctionInfoOffset));
+  __ sub(FieldOperand(shared.reg(), SharedFunctionInfo::kHotnessCountOffset),
+         Immediate(Smi::FromInt(1)));
+  shared.Unuse();
+  deferred->Branch(negative);
+  deferred->BindExit();
+}
+
+
 void CodeGenerator::VisitAndSpill(Statement* statement) {
   ASSERT(in_spilled_code());
   set_in_spilled_code(false);
@@ -2799,6 +2846,7 @@ void CodeGenerator::VisitLoopStatement(LoopStatement* node) {
       }
 
       CheckStack();  // TODO(1222600): ignore if body contains calls.
+      UpdateHotnessCount();
       Visit(node->body());
 
       // Compile the test.
@@ -2895,6 +2943,7 @@ void CodeGenerator::VisitLoopStatement(LoopStatement* node) {
       }
 
       CheckStack();  // TODO(1222600): ignore if body contains calls.
+      UpdateHotnessCount();
       Visit(node->body());
 
       // Based on the condition analysis, compile the backward jump as
@@ -3015,6 +3064,7 @@ void CodeGenerator::VisitLoopStatement(LoopStatement* node) {
       }
 
       CheckStack();  // TODO(1222600): ignore if body contains calls.
+      UpdateHotnessCount();
       Visit(node->body());
 
       // If there is an update expression, compile it if necessary.
@@ -3254,6 +3304,7 @@ void CodeGenerator::VisitForInStatement(ForInStatement* node) {
 
   // Body.
   CheckStack();  // TODO(1222600): ignore if body contains calls.
+  UpdateHotnessCount();
   VisitAndSpill(node->body());
 
   // Next.  Reestablish a spilled frame in case we are coming here via
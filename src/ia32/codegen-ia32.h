@@ -292,7 +292,8 @@ class CodeGenerator: public AstVisitor {
   // be called by compiler.cc.
   static Handle<Code> MakeCode(FunctionLiteral* fun,
                                Handle<Script> script,
-                               bool is_eval);
+                               bool is_eval,
+                               bool is_optimizing);
 
 #ifdef ENABLE_LOGGING_AND_PROFILING
   static bool ShouldGenerateLog(Expression* type);
@@ -335,12 +336,16 @@ class CodeGenerator: public AstVisitor {
 
  private:
   // Construction/Destruction
-  CodeGenerator(int buffer_size, Handle<Script> script, bool is_eval);
+  CodeGenerator(int buffer_size,
+                Handle<Script> script,
+                bool is_eval,
+                bool is_optimizing);
   virtual ~CodeGenerator() { delete masm_; }
 
   // Accessors
   Scope* scope() const { return scope_; }
   bool is_eval() { return is_eval_; }
+  bool is_optimizing() { return is_optimizing_; }
 
   // Generating deferred code.
   void ProcessDeferred();
@@ -494,6 +499,10 @@ class CodeGenerator: public AstVisitor {
 
   void CheckStack();
 
+  // Count down the hotness count of the function and have it recompiled
+  // by the optimizing compiler when the count runs out.
+  void UpdateHotnessCount();
+
   struct InlineRuntimeLUT {
     void (CodeGenerator::*method)(ZoneList<Expression*>*);
     const char* name;
@@ -568,6 +577,7 @@ class CodeGenerator: public AstVisitor {
 #endif
 
   bool is_eval_;  // Tells whether code is generated for eval.
+  bool is_optimizing_;  // Tells whether a hot function is recompiled.
   Handle<Script> script_;
   ZoneList<DeferredCode*> deferred_;
 
@@ -69,6 +69,7 @@ namespace internal {
  *       - backup of caller ebx
  *       - Offset of location before start of input (effectively character
  *         position -1). Used to initialize capture registers to a non-position.
+ *       - Number of backtracks so far.
  *       - register 0  ebp[-4]  (Only positions must be stored in the first
  *       - register 1  ebp[-8]   num_saved_registers_ registers)
  *       - ...
@@ -97,6 +98,7 @@ RegExpMacroAssemblerIA32::RegExpMacroAssemblerIA32(
       mode_(mode),
       num_registers_(registers_to_save),
       num_saved_registers_(registers_to_save),
+      backtrack_limit_(FLAG_regexp_backtrack_limit),
       entry_label_(),
       start_label_(),
       success_label_(),
@@ -117,6 +119,7 @@ RegExpMacroAssemblerIA32::~RegExpMacroAssemblerIA32() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -144,6 +147,11 @@ void RegExpMacroAssemblerIA32::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerIA32::Backtrack() {
   CheckPreemption();
+  if (backtrack_limit_ > 0) {
+    __ inc(Operand(ebp, kBacktrackCount));
+    __ cmp(Operand(ebp, kBacktrackCount), Immediate(backtrack_limit_));
+    __ j(greater, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(ebx);
   __ add(Operand(ebx), Immediate(masm_->CodeObject()));
@@ -292,7 +300,15 @@ void RegExpMacroAssemblerIA32::CheckNotBackReferenceIgnoreCase(
     __ or_(eax, 0x20);  // Convert match character to lower-case.
     __ lea(ecx, Operand(eax, -'a'));
     __ cmp(ecx, static_cast<int32_t>('z' - 'a'));  // Is eax a lowercase letter?
+    Label convert_capture;
+    __ j(below_equal, &convert_capture);
+    // Latin-1 lower-case letters are \u00e0 to \u00fe, except \u00f7.
+    __ sub(Operand(ecx), Immediate(0xe0 - 'a'));
+    __ cmp(ecx, static_cast<int32_t>(0xfe - 0xe0));
     __ j(above, &fail);
+    __ cmp(ecx, static_cast<int32_t>(0xf7 - 0xe0));
+    __ j(equal, &fail);
+    __ bind(&convert_capture);
     // Also convert capture character.
     __ movzx_b(ecx, Operand(edx, 0));
     __ or_(ecx, 0x20);
@@ -491,7 +507,7 @@ bool RegExpMacroAssemblerIA32::CheckSpecialCharacterClass(uc16 type,
   case 's':
     // Match space-characters
     if (mode_ == ASCII) {
-      // ASCII space characters are '\t'..'\r' and ' '.
+      // Latin-1 space characters are '\t'..'\r', ' ' and \u00a0.
       if (check_offset) {
         LoadCurrentCharacter(cp_offset, on_no_match);
       } else {
@@ -503,7 +519,9 @@ bool RegExpMacroAssemblerIA32::CheckSpecialCharacterClass(uc16 type,
       // Check range 0x09..0x0d
       __ sub(Operand(current_character()), Immediate('\t'));
       __ cmp(current_character(), '\r' - '\t');
-      BranchOrBacktrack(above, on_no_match);
+      __ j(below_equal, &success);
+      __ cmp(current_character(), 0x00a0 - '\t');
+      BranchOrBacktrack(not_equal, on_no_match);
       __ bind(&success);
       return true;
     }
@@ -516,12 +534,14 @@ bool RegExpMacroAssemblerIA32::CheckSpecialCharacterClass(uc16 type,
       LoadCurrentCharacterUnchecked(cp_offset, 1);
     }
     if (mode_ == ASCII) {
-      // ASCII space characters are '\t'..'\r' and ' '.
+      // Latin-1 space characters are '\t'..'\r', ' ' and \u00a0.
       __ cmp(current_character(), ' ');
       BranchOrBacktrack(equal, on_no_match);
       __ sub(Operand(current_character()), Immediate('\t'));
       __ cmp(current_character(), '\r' - '\t');
       BranchOrBacktrack(below_equal, on_no_match);
+      __ cmp(current_character(), 0x00a0 - '\t');
+      BranchOrBacktrack(equal, on_no_match);
       return true;
     }
     return false;
@@ -632,6 +652,7 @@ Handle<Object> RegExpMacroAssemblerIA32::GetCode(Handle<String> source) {
   __ push(edi);
   __ push(ebx);  // Callee-save on MacOS.
   __ push(Immediate(0));  // Make room for "input start - 1" constant.
+  __ push(Immediate(0));  // The backtrack count starts at zero.
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -799,6 +820,12 @@ Handle<Object> RegExpMacroAssemblerIA32::GetCode(Handle<String> source) {
     SafeReturn();
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    __ bind(&backtrack_limit_label_);
+    __ mov(eax, kBacktrackLimitExceeded);
+    __ jmp(&exit_label_);
+  }
+
   if (exit_with_exception.is_linked()) {
     // If any of the code above needed to exit with an exception.
     __ bind(&exit_with_exception);
@@ -1033,6 +1060,10 @@ RegExpMacroAssemblerIA32::Result RegExpMacroAssemblerIA32::Execute(
                             output,
                             at_start_val,
                             stack_top);
+  if (result == kBacktrackLimitExceeded) {
+    RegExpImpl::ThrowBacktrackLimitExceeded();
+    return EXCEPTION;
+  }
   ASSERT(result <= SUCCESS);
   ASSERT(result >= RETRY);
 
@@ -1060,6 +1091,10 @@ int RegExpMacroAssemblerIA32::CaseInsensitiveCompareUC16(Address byte_offset1,
     unibrow::uchar c1 = substring1[i];
     unibrow::uchar c2 = substring2[i];
     if (c1 != c2) {
+      if (c1 < 128 || c2 < 128) {
+        if (!AsciiCaseIndependentEquals(c1, c2)) return 0;
+        continue;
+      }
       canonicalize.get(c1, '\0', &c1);
       if (c1 != c2) {
         canonicalize.get(c2, '\0', &c2);
@@ -158,8 +158,13 @@ class RegExpMacroAssemblerIA32: public RegExpMacroAssembler {
   static const int kBackup_edi = kBackup_esi - kPointerSize;
   static const int kBackup_ebx = kBackup_edi - kPointerSize;
   static const int kInputStartMinusOne = kBackup_ebx - kPointerSize;
+  static const int kBacktrackCount = kInputStartMinusOne - kPointerSize;
   // First register address. Following registers are below it on the stack.
-  static const int kRegisterZero = kInputStartMinusOne - kPointerSize;
+  static const int kRegisterZero = kBacktrackCount - kPointerSize;
+
+  // Returned by the generated code when the match has backtracked more
+  // than backtrack_limit_ times. Execute turns it into an exception.
+  static const int kBacktrackLimitExceeded = -3;
 
   // Initial size of code buffer.
   static const size_t kRegExpCodeSize = 1024;
@@ -271,6 +276,10 @@ class RegExpMacroAssemblerIA32: public RegExpMacroAssembler {
   // are always 0..num_saved_registers_-1)
   int num_saved_registers_;
 
+  // Number of backtracks after which the match is aborted, or zero if
+  // there is no limit.
+  int backtrack_limit_;
+
   // Labels used internally.
   Label entry_label_;
   Label start_label_;
@@ -279,6 +288,7 @@ class RegExpMacroAssemblerIA32: public RegExpMacroAssembler {
   Label exit_label_;
   Label check_preempt_label_;
   Label stack_overflow_label_;
+  Label backtrack_limit_label_;
 };
 
 }}  // namespace v8::internal
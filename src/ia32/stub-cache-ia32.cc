@@ -45,6 +45,9 @@ static void ProbeTable(MacroAssembler* masm,
                        Register extra) {
   ExternalReference key_offset(SCTableReference::keyReference(table));
   ExternalReference value_offset(SCTableReference::valueReference(table));
+  StatsCounter* hit_counter = (table == StubCache::kPrimary)
+      ? &Counters::megamorphic_stub_cache_primary_hits
+      : &Counters::megamorphic_stub_cache_secondary_hits;
 
   Label miss;
 
@@ -61,6 +64,7 @@ static void ProbeTable(MacroAssembler* masm,
     __ and_(offset, ~Code::kFlagsNotUsedInLookup);
     __ cmp(offset, flags);
     __ j(not_equal, &miss);
+    __ IncrementCounter(hit_counter, 1);
 
     // Jump to the first instruction in the code stub.
     __ add(Operand(extra), Immediate(Code::kHeaderSize - kHeapObjectTag));
@@ -83,6 +87,7 @@ static void ProbeTable(MacroAssembler* masm,
     __ and_(offset, ~Code::kFlagsNotUsedInLookup);
     __ cmp(offset, flags);
     __ j(not_equal, &miss);
+    __ IncrementCounter(hit_counter, 1);
 
     // Restore offset and re-load code entry from cache.
     __ pop(offset);
@@ -121,6 +126,12 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   ASSERT(!extra.is(name));
   ASSERT(!extra.is(scratch));
 
+  // The table sizes can change at runtime, so the masks are read from
+  // memory.
+  ExternalReference primary_mask(SCTableReference::maskReference(kPrimary));
+  ExternalReference secondary_mask(
+      SCTableReference::maskReference(kSecondary));
+
   // Check that the receiver isn't a smi.
   __ test(receiver, Immediate(kSmiTagMask));
   __ j(zero, &miss, not_taken);
@@ -129,7 +140,7 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ mov(scratch, FieldOperand(name, String::kLengthOffset));
   __ add(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, flags);
-  __ and_(scratch, (kPrimaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(primary_mask));
 
   // Probe the primary table.
   ProbeTable(masm, flags, kPrimary, name, scratch, extra);
@@ -138,10 +149,10 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   __ mov(scratch, FieldOperand(name, String::kLengthOffset));
   __ add(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
   __ xor_(scratch, flags);
-  __ and_(scratch, (kPrimaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(primary_mask));
   __ sub(scratch, Operand(name));
   __ add(Operand(scratch), Immediate(flags));
-  __ and_(scratch, (kSecondaryTableSize - 1) << kHeapObjectTagSize);
+  __ and_(scratch, Operand::StaticVariable(secondary_mask));
 
   // Probe the secondary table.
   ProbeTable(masm, flags, kSecondary, name, scratch, extra);
@@ -149,6 +160,7 @@ void StubCache::GenerateProbe(MacroAssembler* masm,
   // Cache miss: Fall-through and let caller handle the miss by
   // entering the runtime system.
   __ bind(&miss);
+  __ IncrementCounter(&Counters::megamorphic_stub_cache_misses, 1);
 }
 
 
@@ -310,6 +322,27 @@ void StubCompiler::GenerateLoadMiss(MacroAssembler* masm, Code::Kind kind) {
 }
 
 
+void StubCompiler::GenerateMapDispatch(MacroAssembler* masm,
+                                       Register receiver,
+                                       Register scratch,
+                                       int count,
+                                       Map** maps,
+                                       Code** handlers,
+                                       Label* miss_label) {
+  // Check that the receiver isn't a smi.
+  __ test(receiver, Immediate(kSmiTagMask));
+  __ j(zero, miss_label, not_taken);
+
+  // Jump to the handler for the receiver map.  The handlers expect the
+  // same state as the stub itself and check the map again.
+  __ mov(scratch, FieldOperand(receiver, HeapObject::kMapOffset));
+  for (int i = 0; i < count; i++) {
+    __ cmp(Operand(scratch), Immediate(Handle<Map>(maps[i])));
+    __ j(equal, Handle<Code>(handlers[i]));
+  }
+}
+
+
 void StubCompiler::GenerateStoreField(MacroAssembler* masm,
                                       Builtins::Name storage_extend,
                                       JSObject* object,
@@ -721,11 +754,14 @@ Object* CallStubCompiler::CompileCallConstant(Object* object,
   __ mov(esi, FieldOperand(edi, JSFunction::kContextOffset));
 
   // Jump to the cached code (tail call).
+  // The code is loaded through the shared function info so that the
+  // call reaches the code of a hot function once it is recompiled.
   ASSERT(function->is_compiled());
-  Handle<Code> code(function->code());
+  __ mov(edx, FieldOperand(edi, JSFunction::kSharedFunctionInfoOffset));
+  __ mov(edx, FieldOperand(edx, SharedFunctionInfo::kCodeOffset));
+  __ lea(edx, FieldOperand(edx, Code::kHeaderSize));
   ParameterCount expected(function->shared()->formal_parameter_count());
-  __ InvokeCode(code, expected, arguments(),
-                RelocInfo::CODE_TARGET, JUMP_FUNCTION);
+  __ InvokeCode(Operand(edx), expected, arguments(), JUMP_FUNCTION);
 
   // Handle call cache miss.
   __ bind(&miss);
@@ -862,11 +898,14 @@ Object* CallStubCompiler::CompileCallGlobal(JSObject* object,
   __ mov(esi, FieldOperand(edi, JSFunction::kContextOffset));
 
   // Jump to the cached code (tail call).
+  // The code is loaded through the shared function info so that the
+  // call reaches the code of a hot function once it is recompiled.
   ASSERT(function->is_compiled());
-  Handle<Code> code(function->code());
+  __ mov(edx, FieldOperand(edi, JSFunction::kSharedFunctionInfoOffset));
+  __ mov(edx, FieldOperand(edx, SharedFunctionInfo::kCodeOffset));
+  __ lea(edx, FieldOperand(edx, Code::kHeaderSize));
   ParameterCount expected(function->shared()->formal_parameter_count());
-  __ InvokeCode(code, expected, arguments(),
-                RelocInfo::CODE_TARGET, JUMP_FUNCTION);
+  __ InvokeCode(Operand(edx), expected, arguments(), JUMP_FUNCTION);
 
   // Handle call cache miss.
   __ bind(&miss);
@@ -880,6 +919,30 @@ Object* CallStubCompiler::CompileCallGlobal(JSObject* object,
 }
 
 
+Object* CallStubCompiler::CompileCallPolymorphic(int count,
+                                                 Map** maps,
+                                                 Code** handlers,
+                                                 String* name) {
+  // ----------- S t a t e -------------
+  // -----------------------------------
+  Label miss;
+
+  // Get the receiver from the stack.
+  const int argc = arguments().immediate();
+  __ mov(edx, Operand(esp, (argc + 1) * kPointerSize));
+
+  GenerateMapDispatch(masm(), edx, ebx, count, maps, handlers, &miss);
+
+  // Handle call cache miss.
+  __ bind(&miss);
+  Handle<Code> ic = ComputeCallMiss(arguments().immediate());
+  __ jmp(ic, RelocInfo::CODE_TARGET);
+
+  // Return the generated code.
+  return GetPolymorphicCode(name);
+}
+
+
 Object* StoreStubCompiler::CompileStoreField(JSObject* object,
                                              int index,
                                              Map* transition,
@@ -1253,6 +1316,27 @@ Object* LoadStubCompiler::CompileLoadGlobal(JSObject* object,
 }
 
 
+Object* LoadStubCompiler::CompileLoadPolymorphic(int count,
+                                                 Map** maps,
+                                                 Code** handlers,
+                                                 String* name) {
+  // ----------- S t a t e -------------
+  //  -- ecx    : name
+  //  -- esp[0] : return address
+  //  -- esp[4] : receiver
+  // -----------------------------------
+  Label miss;
+
+  __ mov(eax, (Operand(esp, kPointerSize)));
+  GenerateMapDispatch(masm(), eax, ebx, count, maps, handlers, &miss);
+  __ bind(&miss);
+  GenerateLoadMiss(masm(), Code::LOAD_IC);
+
+  // Return the generated code.
+  return GetPolymorphicCode(name);
+}
+
+
 Object* KeyedLoadStubCompiler::CompileLoadField(String* name,
                                                 JSObject* receiver,
                                                 JSObject* holder,
@@ -45,6 +45,7 @@ static char TransitionMarkFromState(IC::State state) {
     case PREMONOMORPHIC: return 'P';
     case MONOMORPHIC: return '1';
     case MONOMORPHIC_PROTOTYPE_FAILURE: return '^';
+    case POLYMORPHIC: return '2';
     case MEGAMORPHIC: return 'N';
 
     // We never see the debugger states here, because the state is
@@ -131,14 +132,93 @@ Address IC::OriginalCodeAddress() {
 }
 #endif
 
+// Collects the receiver maps and handlers of a polymorphic stub.  The
+// stub embeds the maps in order, each followed by a jump to its
+// handler; the final code target is the miss stub.
+static int CollectPolymorphicCases(Code* target, Map** maps, Code** handlers) {
+  ASSERT(target->ic_state() == POLYMORPHIC);
+  int map_count = 0;
+  int handler_count = 0;
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT) |
+                  RelocInfo::kCodeTargetMask;
+  for (RelocIterator it(target, mode_mask); !it.done(); it.next()) {
+    RelocInfo* info = it.rinfo();
+    if (info->rmode() == RelocInfo::EMBEDDED_OBJECT) {
+      Object* object = info->target_object();
+      if (!object->IsMap()) continue;
+      ASSERT(map_count < IC::kMaxPolymorphicCases);
+      maps[map_count++] = Map::cast(object);
+    } else if (handler_count < map_count) {
+      handlers[handler_count++] =
+          Code::GetCodeFromTargetAddress(info->target_address());
+    }
+  }
+  ASSERT(handler_count == map_count);
+  return map_count;
+}
+
+
+int IC::ComputePolymorphicCases(Code* target,
+                                Map* map,
+                                Code* handler,
+                                Map** maps,
+                                Code** handlers) {
+  int count = 0;
+  if (target->ic_state() == MONOMORPHIC) {
+    // Monomorphic stubs start by checking the map they are cached
+    // under.  Stubs for value receivers check the map of a prototype
+    // instead, and some builtins do not check a map at all; those
+    // cannot be dispatched on.
+    Map* target_map = target->FindFirstMap();
+    if (target_map == NULL ||
+        target_map->instance_type() == JS_VALUE_TYPE ||
+        target_map->IndexInCodeCache(target) < 0) {
+      return -1;
+    }
+    maps[0] = target_map;
+    handlers[0] = target;
+    count = 1;
+  } else {
+    count = CollectPolymorphicCases(target, maps, handlers);
+  }
+
+  for (int i = 0; i < count; i++) {
+    if (maps[i] == map) {
+      handlers[i] = handler;
+      return count;
+    }
+  }
+  if (count == kMaxPolymorphicCases) return -1;
+  maps[count] = map;
+  handlers[count] = handler;
+  return count + 1;
+}
+
+
 IC::State IC::StateFrom(Code* target, Object* receiver) {
   IC::State state = target->ic_state();
 
-  if (state != MONOMORPHIC) return state;
+  if (state != MONOMORPHIC && state != POLYMORPHIC) return state;
   if (receiver->IsUndefined() || receiver->IsNull()) return state;
 
   Map* map = GetCodeCacheMapForObject(receiver);
 
+  if (state == POLYMORPHIC) {
+    // A miss on one of the dispatched maps means the handler for it
+    // failed its prototype checks.  Remove the handler from the map's
+    // code cache so it is recompiled.
+    Map* maps[kMaxPolymorphicCases];
+    Code* handlers[kMaxPolymorphicCases];
+    int count = CollectPolymorphicCases(target, maps, handlers);
+    for (int i = 0; i < count; i++) {
+      if (maps[i] != map) continue;
+      int index = map->IndexInCodeCache(handlers[i]);
+      if (index >= 0) map->RemoveFromCodeCache(index);
+      return MONOMORPHIC_PROTOTYPE_FAILURE;
+    }
+    return POLYMORPHIC;
+  }
+
   // Decide whether the inline cache failed because of changes to the
   // receiver itself or changes to one of its prototypes.
   //
@@ -428,7 +508,9 @@ void CallIC::UpdateCaches(LookupResult* lookup,
     // Set the target to the pre monomorphic stub to delay
     // setting the monomorphic state.
     code = StubCache::ComputeCallPreMonomorphic(argc, in_loop);
-  } else if (state == MONOMORPHIC) {
+  } else if ((state == MONOMORPHIC || state == POLYMORPHIC) &&
+             !object->IsJSObject()) {
+    // Calls on values are only dispatched on in monomorphic state.
     code = StubCache::ComputeCallMegamorphic(argc, in_loop);
   } else {
     // Compute monomorphic stub.
@@ -491,10 +573,30 @@ void CallIC::UpdateCaches(LookupResult* lookup,
   if (code == NULL || code->IsFailure()) return;
 
   // Patch the call site depending on the state of the cache.
-  if (state == UNINITIALIZED ||
-      state == PREMONOMORPHIC ||
-      state == MONOMORPHIC ||
-      state == MONOMORPHIC_PROTOTYPE_FAILURE) {
+  if ((state == MONOMORPHIC || state == POLYMORPHIC) &&
+      object->IsJSObject()) {
+    // Dispatch on a few receiver maps before going megamorphic.
+    Map* maps[kMaxPolymorphicCases];
+    Code* handlers[kMaxPolymorphicCases];
+    int count = ComputePolymorphicCases(target(),
+                                        JSObject::cast(*object)->map(),
+                                        Code::cast(code),
+                                        maps,
+                                        handlers);
+    if (count > 0) {
+      code = StubCache::ComputeCallPolymorphic(argc, in_loop, *name,
+                                               count, maps, handlers);
+    }
+    if (count <= 0 || code->IsFailure()) {
+      code = StubCache::ComputeCallMegamorphic(argc, in_loop);
+      if (code->IsFailure()) return;
+    }
+    set_target(Code::cast(code));
+  } else if (state == UNINITIALIZED ||
+             state == PREMONOMORPHIC ||
+             state == MONOMORPHIC ||
+             state == MONOMORPHIC_PROTOTYPE_FAILURE ||
+             state == POLYMORPHIC) {
     set_target(Code::cast(code));
   }
 
@@ -704,8 +806,22 @@ void LoadIC::UpdateCaches(LookupResult* lookup,
   if (state == UNINITIALIZED || state == PREMONOMORPHIC ||
       state == MONOMORPHIC_PROTOTYPE_FAILURE) {
     set_target(Code::cast(code));
-  } else if (state == MONOMORPHIC) {
-    set_target(megamorphic_stub());
+  } else if (state == MONOMORPHIC || state == POLYMORPHIC) {
+    // Dispatch on a few receiver maps before going megamorphic.
+    Map* maps[kMaxPolymorphicCases];
+    Code* handlers[kMaxPolymorphicCases];
+    int count = ComputePolymorphicCases(target(),
+                                        receiver->map(),
+                                        Code::cast(code),
+                                        maps,
+                                        handlers);
+    Object* stub = megamorphic_stub();
+    if (count > 0) {
+      Object* polymorphic =
+          StubCache::ComputeLoadPolymorphic(*name, count, maps, handlers);
+      if (!polymorphic->IsFailure()) stub = polymorphic;
+    }
+    set_target(Code::cast(stub));
   }
 
 #ifdef DEBUG
@@ -714,6 +830,36 @@ void LoadIC::UpdateCaches(LookupResult* lookup,
 }
 
 
+Map* LoadIC::FindInobjectFieldLoad(Code* target, String** name, int* offset) {
+  if (target->kind() != Code::LOAD_IC ||
+      target->ic_state() != MONOMORPHIC ||
+      target->type() != FIELD) {
+    return NULL;
+  }
+  Map* map = target->FindFirstMap();
+  if (map == NULL || map->is_access_check_needed()) return NULL;
+
+  // The stub is cached in the code cache of the receiver map under the
+  // name of the property.
+  int index = map->IndexInCodeCache(target);
+  if (index < 0) return NULL;
+  String* key = String::cast(map->code_cache()->get(index - 1));
+
+  // Fields of the prototypes and fields in the properties array are
+  // not loaded by the inlined code.
+  DescriptorArray* descriptors = map->instance_descriptors();
+  int number = descriptors->Search(key);
+  if (number == DescriptorArray::kNotFound) return NULL;
+  if (descriptors->GetType(number) != FIELD) return NULL;
+  int field = descriptors->GetFieldIndex(number) - map->inobject_properties();
+  if (field >= 0) return NULL;
+
+  *name = key;
+  *offset = map->instance_size() + (field * kPointerSize);
+  return map;
+}
+
+
 Object* KeyedLoadIC::Load(State state,
                           Handle<Object> object,
                           Handle<Object> key) {
@@ -104,6 +104,10 @@ class IC {
   // This method should not be called with undefined or null.
   static inline Map* GetCodeCacheMapForObject(Object* object);
 
+  // The maximum number of receiver maps a polymorphic inline cache
+  // dispatches on before going megamorphic.
+  static const int kMaxPolymorphicCases = 4;
+
  protected:
   Address fp() const { return fp_; }
   Address pc() const { return *pc_address_; }
@@ -117,6 +121,15 @@ class IC {
   // Set the call-site target.
   void set_target(Code* code) { SetTargetAtAddress(address(), code); }
 
+  // Collects the receiver maps and handlers dispatched on by the target
+  // and adds the handler for the given map.  Returns the number of
+  // cases, or -1 if the call site should go megamorphic instead.
+  static int ComputePolymorphicCases(Code* target,
+                                     Map* map,
+                                     Code* handler,
+                                     Map** maps,
+                                     Code** handlers);
+
 #ifdef DEBUG
   static void TraceIC(const char* type,
                       Handle<String> name,
@@ -223,6 +236,16 @@ class LoadIC: public IC {
   // 6 bytes (jne slow_label).
   static const int kOffsetToLoadInstruction;
 
+  // Support for recompiling hot functions.  If target is a monomorphic
+  // stub that loads an inobject field of its receiver, returns the
+  // receiver map and sets name and offset to the name and the offset
+  // of the field.  Returns NULL otherwise.
+  static Map* FindInobjectFieldLoad(Code* target, String** name, int* offset);
+
+  // Patch the map check and the offset of the inlined load following
+  // the call at address.  Returns false if the load was not inlined.
+  static bool PatchInlinedLoad(Address address, Object* map, int index);
+
  private:
   static void Generate(MacroAssembler* masm, const ExternalReference& f);
 
@@ -249,8 +272,6 @@ class LoadIC: public IC {
   // Clear the use of the inlined version.
   static void ClearInlinedVersion(Address address);
 
-  static bool PatchInlinedLoad(Address address, Object* map, int index);
-
   friend class IC;
 };
 
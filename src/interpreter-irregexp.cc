@@ -33,7 +33,10 @@
 #include "utils.h"
 #include "ast.h"
 #include "bytecodes-irregexp.h"
+#include "execution.h"
 #include "interpreter-irregexp.h"
+#include "jsregexp.h"
+#include "regexp-macro-assembler.h"
 
 
 namespace v8 {
@@ -51,6 +54,13 @@ static bool BackRefMatchesNoCase(int from,
     unibrow::uchar old_char = subject[from++];
     unibrow::uchar new_char = subject[current++];
     if (old_char == new_char) continue;
+    if (old_char < 128 || new_char < 128) {
+      if (!RegExpMacroAssembler::AsciiCaseIndependentEquals(old_char,
+                                                            new_char)) {
+        return false;
+      }
+      continue;
+    }
     interp_canonicalize.get(old_char, '\0', &old_char);
     interp_canonicalize.get(new_char, '\0', &new_char);
     if (old_char != new_char) {
@@ -61,16 +71,23 @@ static bool BackRefMatchesNoCase(int from,
 }
 
 
+// Within Latin-1 the only case pairs are 'A'-'Z' and \u00c0-\u00de (except
+// \u00d7), which differ from their lower case forms in bit 5.
+static inline bool IsLatin1UpperCaseLetter(unsigned int c) {
+  return c - 'A' <= 'Z' - 'A' || (c - 0xc0 <= 0xde - 0xc0 && c != 0xd7);
+}
+
+
 static bool BackRefMatchesNoCase(int from,
                                  int current,
                                  int len,
-                                 Vector<const char> subject) {
+                                 Vector<const byte> subject) {
   for (int i = 0; i < len; i++) {
     unsigned int old_char = subject[from++];
     unsigned int new_char = subject[current++];
     if (old_char == new_char) continue;
-    if (old_char - 'A' <= 'Z' - 'A') old_char |= 0x20;
-    if (new_char - 'A' <= 'Z' - 'A') new_char |= 0x20;
+    if (IsLatin1UpperCaseLetter(old_char)) old_char |= 0x20;
+    if (IsLatin1UpperCaseLetter(new_char)) new_char |= 0x20;
     if (old_char != new_char) return false;
   }
   return true;
@@ -115,18 +132,44 @@ static void TraceInterpreter(const byte* code_base,
 }
 
 
+#define TRACE_BYTECODE(name)                            \
+  TraceInterpreter(code_base,                           \
+                   pc,                                  \
+                   backtrack_sp - backtrack_stack_base, \
+                   current,                             \
+                   current_char,                        \
+                   BC_##name##_LENGTH,                  \
+                   #name);
+#else
+#define TRACE_BYTECODE(name)
+#endif
+
+
+// Where label addresses are available the interpreter jumps straight from
+// the end of one bytecode handler to the next through a table of them, so
+// each handler gets its own indirect branch instead of sharing the one in the
+// switch.  Only compilers that can be told to accept the extension under
+// -pedantic use it.
+#if defined(__clang__) || (defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)))
+#define IRREGEXP_THREADED_DISPATCH
+#endif
+
+#ifdef IRREGEXP_THREADED_DISPATCH
 #define BYTECODE(name)                                    \
-  case BC_##name:                                         \
-    TraceInterpreter(code_base,                           \
-                     pc,                                  \
-                     backtrack_sp - backtrack_stack_base, \
-                     current,                             \
-                     current_char,                        \
-                     BC_##name##_LENGTH,                  \
-                     #name);
+  BC_##name##_HANDLER:                                    \
+    TRACE_BYTECODE(name)
+#define DISPATCH()                                          \
+  do {                                                      \
+    insn = Load32Aligned(pc);                               \
+    ASSERT((insn & BYTECODE_MASK) < kRegExpBytecodeCount);  \
+    goto *dispatch_table[insn & BYTECODE_MASK];             \
+  } while (false)
 #else
 #define BYTECODE(name)                                    \
-  case BC_##name:
+  case BC_##name:                                         \
+    TRACE_BYTECODE(name)
+#define DISPATCH() break
 #endif
 
 
@@ -185,13 +228,59 @@ class BacktrackStack {
 int* BacktrackStack::cache_ = NULL;
 
 
+// Number of backtracks between checks for interrupts and for the backtrack
+// limit.
+static const int kBacktrackCheckInterval = 1 << 10;
+
+
+// Called every kBacktrackCheckInterval backtracks.  Throws if the match has
+// backtracked more than --regexp-backtrack-limit times, and otherwise
+// handles pending interrupts.  Returns SUCCESS if matching can go on, but
+// the code and the subject may have been moved by a garbage collection.
+static IrregexpInterpreter::Result CheckBacktracks(int backtracks) {
+  DisableAssertNoAllocation allow_allocation;
+  if (FLAG_regexp_backtrack_limit > 0 &&
+      backtracks > FLAG_regexp_backtrack_limit) {
+    RegExpImpl::ThrowBacktrackLimitExceeded();
+    return IrregexpInterpreter::EXCEPTION;
+  }
+  if (StackGuard::HasPendingInterrupts() &&
+      Execution::HandleStackGuardInterrupt()->IsException()) {
+    return IrregexpInterpreter::EXCEPTION;
+  }
+  return IrregexpInterpreter::SUCCESS;
+}
+
+
+static inline void LoadSubject(Handle<String> subject,
+                               Vector<const byte>* chars) {
+  *chars = subject->ToOneByteVector();
+}
+
+
+static inline void LoadSubject(Handle<String> subject,
+                               Vector<const uc16>* chars) {
+  *chars = subject->ToUC16Vector();
+}
+
+
+#ifdef IRREGEXP_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
 template <typename Char>
-static bool RawMatch(const byte* code_base,
-                     Vector<const Char> subject,
-                     int* registers,
-                     int current,
-                     uint32_t current_char) {
+static IrregexpInterpreter::Result RawMatch(Handle<ByteArray> code_array,
+                                           Handle<String> subject_string,
+                                           int* registers,
+                                           int current,
+                                           uint32_t current_char) {
+  const byte* code_base = code_array->GetDataStartAddress();
+  Vector<const Char> subject;
+  LoadSubject(subject_string, &subject);
   const byte* pc = code_base;
+  int backtracks = 0;
+  int backtracks_until_check = kBacktrackCheckInterval;
   // BacktrackStack ensures that the memory allocated for the backtracking stack
   // is returned to the system or cached if there is no stack being cached at
   // the moment.
@@ -204,91 +293,119 @@ static bool RawMatch(const byte* code_base,
     PrintF("\n\nStart bytecode interpreter\n\n");
   }
 #endif
+#ifdef IRREGEXP_THREADED_DISPATCH
+#define DECLARE_HANDLER_ADDRESS(name, code, length) \
+    &&BC_##name##_HANDLER,
+  static const void* const dispatch_table[] = {
+    BYTECODE_ITERATOR(DECLARE_HANDLER_ADDRESS)
+  };
+#undef DECLARE_HANDLER_ADDRESS
+  int32_t insn;
+  DISPATCH();
+  // These braces stand in for those of the loop and switch below.
+  {
+    {
+#else
   while (true) {
     int32_t insn = Load32Aligned(pc);
     switch (insn & BYTECODE_MASK) {
+#endif
       BYTECODE(BREAK)
         UNREACHABLE();
-        return false;
+        return IrregexpInterpreter::FAILURE;
       BYTECODE(PUSH_CP)
         if (--backtrack_stack_space < 0) {
-          return false;  // No match on backtrack stack overflow.
+          // No match on backtrack stack overflow.
+          return IrregexpInterpreter::FAILURE;
         }
         *backtrack_sp++ = current;
         pc += BC_PUSH_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(PUSH_BT)
         if (--backtrack_stack_space < 0) {
-          return false;  // No match on backtrack stack overflow.
+          // No match on backtrack stack overflow.
+          return IrregexpInterpreter::FAILURE;
         }
         *backtrack_sp++ = Load32Aligned(pc + 4);
         pc += BC_PUSH_BT_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(PUSH_REGISTER)
         if (--backtrack_stack_space < 0) {
-          return false;  // No match on backtrack stack overflow.
+          // No match on backtrack stack overflow.
+          return IrregexpInterpreter::FAILURE;
         }
         *backtrack_sp++ = registers[insn >> BYTECODE_SHIFT];
         pc += BC_PUSH_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER)
         registers[insn >> BYTECODE_SHIFT] = Load32Aligned(pc + 4);
         pc += BC_SET_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(ADVANCE_REGISTER)
         registers[insn >> BYTECODE_SHIFT] += Load32Aligned(pc + 4);
         pc += BC_ADVANCE_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER_TO_CP)
         registers[insn >> BYTECODE_SHIFT] = current + Load32Aligned(pc + 4);
         pc += BC_SET_REGISTER_TO_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_CP_TO_REGISTER)
         current = registers[insn >> BYTECODE_SHIFT];
         pc += BC_SET_CP_TO_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER_TO_SP)
         registers[insn >> BYTECODE_SHIFT] = backtrack_sp - backtrack_stack_base;
         pc += BC_SET_REGISTER_TO_SP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_SP_TO_REGISTER)
         backtrack_sp = backtrack_stack_base + registers[insn >> BYTECODE_SHIFT];
         backtrack_stack_space = backtrack_stack.max_size() -
                                 (backtrack_sp - backtrack_stack_base);
         pc += BC_SET_SP_TO_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(POP_CP)
         backtrack_stack_space++;
         --backtrack_sp;
         current = *backtrack_sp;
         pc += BC_POP_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(POP_BT)
         backtrack_stack_space++;
         --backtrack_sp;
+        if (--backtracks_until_check == 0) {
+          backtracks += kBacktrackCheckInterval;
+          backtracks_until_check = kBacktrackCheckInterval;
+          IrregexpInterpreter::Result result = CheckBacktracks(backtracks);
+          if (result != IrregexpInterpreter::SUCCESS) return result;
+          if (subject_string->IsAsciiRepresentation() != (sizeof(Char) == 1)) {
+            return IrregexpInterpreter::RETRY;
+          }
+          code_base = code_array->GetDataStartAddress();
+          LoadSubject(subject_string, &subject);
+        }
         pc = code_base + *backtrack_sp;
-        break;
+        DISPATCH();
       BYTECODE(POP_REGISTER)
         backtrack_stack_space++;
         --backtrack_sp;
         registers[insn >> BYTECODE_SHIFT] = *backtrack_sp;
         pc += BC_POP_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(FAIL)
-        return false;
+        return IrregexpInterpreter::FAILURE;
       BYTECODE(SUCCEED)
-        return true;
+        return IrregexpInterpreter::SUCCESS;
       BYTECODE(ADVANCE_CP)
         current += insn >> BYTECODE_SHIFT;
         pc += BC_ADVANCE_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(GOTO)
         pc = code_base + Load32Aligned(pc + 4);
-        break;
+        DISPATCH();
       BYTECODE(ADVANCE_CP_AND_GOTO)
         current += insn >> BYTECODE_SHIFT;
         pc = code_base + Load32Aligned(pc + 4);
-        break;
+        DISPATCH();
       BYTECODE(CHECK_GREEDY)
         if (current == backtrack_sp[-1]) {
           backtrack_sp--;
@@ -297,7 +414,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_GREEDY_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(LOAD_CURRENT_CHAR) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         if (pos >= subject.length()) {
@@ -306,13 +423,13 @@ static bool RawMatch(const byte* code_base,
           current_char = subject[pos];
           pc += BC_LOAD_CURRENT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_CURRENT_CHAR_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         current_char = subject[pos];
         pc += BC_LOAD_CURRENT_CHAR_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_2_CURRENT_CHARS) {
         int pos = current + (insn >> BYTECODE_SHIFT);
@@ -324,14 +441,14 @@ static bool RawMatch(const byte* code_base,
               (subject[pos] | (next << (kBitsPerByte * sizeof(Char))));
           pc += BC_LOAD_2_CURRENT_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_2_CURRENT_CHARS_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         Char next = subject[pos + 1];
         current_char = (subject[pos] | (next << (kBitsPerByte * sizeof(Char))));
         pc += BC_LOAD_2_CURRENT_CHARS_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_4_CURRENT_CHARS) {
         ASSERT(sizeof(Char) == 1);
@@ -348,7 +465,7 @@ static bool RawMatch(const byte* code_base,
                           (next3 << 24));
           pc += BC_LOAD_4_CURRENT_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_4_CURRENT_CHARS_UNCHECKED) {
         ASSERT(sizeof(Char) == 1);
@@ -361,7 +478,7 @@ static bool RawMatch(const byte* code_base,
                         (next2 << 16) |
                         (next3 << 24));
         pc += BC_LOAD_4_CURRENT_CHARS_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -370,7 +487,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -379,7 +496,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -388,7 +505,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_NOT_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -397,7 +514,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -406,7 +523,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_AND_CHECK_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -415,7 +532,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_AND_CHECK_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_NOT_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -424,7 +541,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_AND_CHECK_NOT_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -433,7 +550,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_AND_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(MINUS_AND_CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -444,7 +561,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_MINUS_AND_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_LT) {
         uint32_t limit = (insn >> BYTECODE_SHIFT);
@@ -453,7 +570,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_LT_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_GT) {
         uint32_t limit = (insn >> BYTECODE_SHIFT);
@@ -462,7 +579,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_GT_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_REGISTER_LT)
         if (registers[insn >> BYTECODE_SHIFT] < Load32Aligned(pc + 4)) {
@@ -470,21 +587,21 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_REGISTER_LT_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_REGISTER_GE)
         if (registers[insn >> BYTECODE_SHIFT] >= Load32Aligned(pc + 4)) {
           pc = code_base + Load32Aligned(pc + 8);
         } else {
           pc += BC_CHECK_REGISTER_GE_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_REGISTER_EQ_POS)
         if (registers[insn >> BYTECODE_SHIFT] == current) {
           pc = code_base + Load32Aligned(pc + 4);
         } else {
           pc += BC_CHECK_REGISTER_EQ_POS_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(LOOKUP_MAP1) {
         // Look up character in a bitmap.  If we find a 0, then jump to the
         // location at pc + 8.  Otherwise fall through!
@@ -496,7 +613,7 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_LOOKUP_MAP1_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOOKUP_MAP2) {
         // Look up character in a half-nibble map.  If we find 00, then jump to
@@ -518,7 +635,7 @@ static bool RawMatch(const byte* code_base,
             pc = code_base + Load32Aligned(pc + 20);
           }
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOOKUP_MAP8) {
         // Look up character in a byte map.  Use the byte as an index into a
@@ -527,7 +644,7 @@ static bool RawMatch(const byte* code_base,
         byte map = code_base[Load32Aligned(pc + 4) + index];
         const byte* new_pc = code_base + Load32Aligned(pc + 8) + (map << 2);
         pc = code_base + Load32Aligned(new_pc);
-        break;
+        DISPATCH();
       }
       BYTECODE(LOOKUP_HI_MAP8) {
         // Look up high byte of this character in a byte map.  Use the byte as
@@ -536,7 +653,7 @@ static bool RawMatch(const byte* code_base,
         byte map = code_base[Load32Aligned(pc + 4) + index];
         const byte* new_pc = code_base + Load32Aligned(pc + 8) + (map << 2);
         pc = code_base + Load32Aligned(new_pc);
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_REGS_EQUAL)
         if (registers[insn >> BYTECODE_SHIFT] ==
@@ -545,17 +662,17 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc = code_base + Load32Aligned(pc + 8);
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_NOT_BACK_REF) {
         int from = registers[insn >> BYTECODE_SHIFT];
         int len = registers[(insn >> BYTECODE_SHIFT) + 1] - from;
         if (from < 0 || len <= 0) {
           pc += BC_CHECK_NOT_BACK_REF_LENGTH;
-          break;
+          DISPATCH();
         }
         if (current + len > subject.length()) {
           pc = code_base + Load32Aligned(pc + 4);
-          break;
+          DISPATCH();
         } else {
           int i;
           for (i = 0; i < len; i++) {
@@ -564,22 +681,22 @@ static bool RawMatch(const byte* code_base,
               break;
             }
           }
-          if (i < len) break;
+          if (i < len) DISPATCH();
           current += len;
         }
         pc += BC_CHECK_NOT_BACK_REF_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_BACK_REF_NO_CASE) {
         int from = registers[insn >> BYTECODE_SHIFT];
         int len = registers[(insn >> BYTECODE_SHIFT) + 1] - from;
         if (from < 0 || len <= 0) {
           pc += BC_CHECK_NOT_BACK_REF_NO_CASE_LENGTH;
-          break;
+          DISPATCH();
         }
         if (current + len > subject.length()) {
           pc = code_base + Load32Aligned(pc + 4);
-          break;
+          DISPATCH();
         } else {
           if (BackRefMatchesNoCase(from, current, len, subject)) {
             current += len;
@@ -588,7 +705,7 @@ static bool RawMatch(const byte* code_base,
             pc = code_base + Load32Aligned(pc + 4);
           }
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_AT_START)
         if (current == 0) {
@@ -596,47 +713,86 @@ static bool RawMatch(const byte* code_base,
         } else {
           pc += BC_CHECK_AT_START_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_NOT_AT_START)
         if (current == 0) {
           pc += BC_CHECK_NOT_AT_START_LENGTH;
         } else {
           pc = code_base + Load32Aligned(pc + 4);
         }
-        break;
+        DISPATCH();
+      BYTECODE(LOAD_CHAR_CHECK_NOT_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        if (pos >= subject.length()) {
+          pc = code_base + Load32Aligned(pc + 4);
+        } else {
+          current_char = subject[pos];
+          if (current_char != static_cast<uint32_t>(Load32Aligned(pc + 8))) {
+            pc = code_base + Load32Aligned(pc + 4);
+          } else {
+            pc += BC_LOAD_CHAR_CHECK_NOT_CHAR_LENGTH;
+          }
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CHAR_UNCHECKED_CHECK_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        current_char = subject[pos];
+        if (current_char == static_cast<uint32_t>(Load32Aligned(pc + 4))) {
+          pc = code_base + Load32Aligned(pc + 8);
+        } else {
+          pc += BC_LOAD_CHAR_UNCHECKED_CHECK_CHAR_LENGTH;
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        current_char = subject[pos];
+        if (current_char != static_cast<uint32_t>(Load32Aligned(pc + 4))) {
+          pc = code_base + Load32Aligned(pc + 8);
+        } else {
+          pc += BC_LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR_LENGTH;
+        }
+        DISPATCH();
+      }
+#ifndef IRREGEXP_THREADED_DISPATCH
       default:
         UNREACHABLE();
         break;
+#endif
     }
   }
 }
 
+#ifdef IRREGEXP_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
 
-bool IrregexpInterpreter::Match(Handle<ByteArray> code_array,
-                                Handle<String> subject,
-                                int* registers,
-                                int start_position) {
+IrregexpInterpreter::Result IrregexpInterpreter::Match(
+    Handle<ByteArray> code_array,
+    Handle<String> subject,
+    int* registers,
+    int start_position) {
   ASSERT(subject->IsFlat());
 
+  // Allocation is only allowed while handling interrupts, after which
+  // RawMatch reloads the code and the subject.
   AssertNoAllocation a;
-  const byte* code_base = code_array->GetDataStartAddress();
   uc16 previous_char = '\n';
+  if (start_position != 0) previous_char = subject->Get(start_position - 1);
   if (subject->IsAsciiRepresentation()) {
-    Vector<const char> subject_vector = subject->ToAsciiVector();
-    if (start_position != 0) previous_char = subject_vector[start_position - 1];
-    return RawMatch(code_base,
-                    subject_vector,
-                    registers,
-                    start_position,
-                    previous_char);
+    return RawMatch<byte>(code_array,
+                          subject,
+                          registers,
+                          start_position,
+                          previous_char);
   } else {
-    Vector<const uc16> subject_vector = subject->ToUC16Vector();
-    if (start_position != 0) previous_char = subject_vector[start_position - 1];
-    return RawMatch(code_base,
-                    subject_vector,
-                    registers,
-                    start_position,
-                    previous_char);
+    return RawMatch<uc16>(code_array,
+                          subject,
+                          registers,
+                          start_position,
+                          previous_char);
   }
 }
 
@@ -36,10 +36,20 @@ namespace internal {
 
 class IrregexpInterpreter {
  public:
-  static bool Match(Handle<ByteArray> code,
-                    Handle<String> subject,
-                    int* captures,
-                    int start_position);
+  // Result of calling Match.  The values are those of the native regexp
+  // code.
+  // RETRY: The subject changed representation while an interrupt was
+  //        handled, and matching should be retried from scratch.
+  // EXCEPTION: An exception was thrown by an interrupt or because the
+  //        match exceeded the backtrack limit.
+  // FAILURE: Matching failed.
+  // SUCCESS: Matching succeeded, and the captures have been filled in.
+  enum Result { RETRY = -2, EXCEPTION = -1, FAILURE = 0, SUCCESS = 1 };
+
+  static Result Match(Handle<ByteArray> code,
+                      Handle<String> subject,
+                      int* captures,
+                      int start_position);
 };
 
 
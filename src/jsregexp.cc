@@ -61,6 +61,12 @@
 namespace v8 {
 namespace internal {
 
+#if V8_TARGET_ARCH_IA32
+typedef RegExpMacroAssemblerIA32 NativeRegExpMacroAssembler;
+#elif V8_TARGET_ARCH_X64
+typedef RegExpMacroAssemblerX64 NativeRegExpMacroAssembler;
+#endif
+
 
 Handle<Object> RegExpImpl::CreateRegExpLiteral(Handle<JSFunction> constructor,
                                                Handle<String> pattern,
@@ -181,6 +187,9 @@ Handle<Object> RegExpImpl::Compile(Handle<JSRegExp> re,
     AtomCompile(re, pattern, flags, atom_string);
   } else {
     IrregexpPrepare(re, pattern, flags, parse_result.capture_count);
+    if (!flags.is_ignore_case() && !parse_result.tree->IsAnchored()) {
+      IrregexpSetRequiredLiteral(re, parse_result.tree);
+    }
   }
   ASSERT(re->data()->IsFixedArray());
   // Compilation succeeded so the data is set on the regexp
@@ -196,22 +205,172 @@ Handle<Object> RegExpImpl::Exec(Handle<JSRegExp> regexp,
                                 Handle<String> subject,
                                 int index,
                                 Handle<JSArray> last_match_info) {
+  bool matched;
+  if (RegExpResultCache::Lookup(regexp,
+                                subject,
+                                index,
+                                last_match_info,
+                                &matched)) {
+    Counters::regexp_result_cache_hits.Increment();
+    if (!matched) return Factory::null_value();
+    return last_match_info;
+  }
+  Counters::regexp_result_cache_misses.Increment();
+
+  Handle<Object> result;
   switch (regexp->TypeTag()) {
     case JSRegExp::ATOM:
-      return AtomExec(regexp, subject, index, last_match_info);
-    case JSRegExp::IRREGEXP: {
-      Handle<Object> result =
-          IrregexpExec(regexp, subject, index, last_match_info);
+      result = AtomExec(regexp, subject, index, last_match_info);
+      break;
+    case JSRegExp::IRREGEXP:
+      result = IrregexpExec(regexp, subject, index, last_match_info);
       ASSERT(!result.is_null() || Top::has_pending_exception());
-      return result;
-    }
+      break;
     default:
       UNREACHABLE();
       return Handle<Object>::null();
   }
+  if (!result.is_null()) {
+    RegExpResultCache::Update(*regexp,
+                              *subject,
+                              index,
+                              *last_match_info,
+                              !result->IsNull());
+  }
+  return result;
 }
 
 
+Handle<Object> RegExpImpl::ExecGlobal(Handle<JSRegExp> regexp,
+                                      Handle<String> subject,
+                                      Handle<JSArray> last_match_info) {
+  Handle<Object> match = Exec(regexp, subject, 0, last_match_info);
+  if (match.is_null() || match->IsNull()) return match;
+
+  int length = subject->length();
+  int capture_registers;
+  {
+    AssertNoAllocation no_alloc;
+    FixedArray* array = FixedArray::cast(last_match_info->elements());
+    capture_registers = GetLastCaptureCount(array);
+  }
+
+  // The positions are collected in the zone and only copied to the heap
+  // once all matches have been found.
+  CompilationZoneScope zone_scope(DELETE_ON_EXIT);
+  ZoneList<int> positions(capture_registers * 4);
+  do {
+    int start;
+    int end;
+    {
+      AssertNoAllocation no_alloc;
+      FixedArray* array = FixedArray::cast(last_match_info->elements());
+      ASSERT_EQ(capture_registers, GetLastCaptureCount(array));
+      for (int i = 0; i < capture_registers; i++) {
+        positions.Add(GetCapture(array, i));
+      }
+      start = GetCapture(array, 0);
+      end = GetCapture(array, 1);
+    }
+    // Continue from where the match ended, unless it was an empty match.
+    int index = start < end ? end : end + 1;
+    if (index > length) break;
+    match = Exec(regexp, subject, index, last_match_info);
+    if (match.is_null()) return match;
+  } while (!match->IsNull());
+
+  Handle<FixedArray> elements = Factory::NewFixedArray(positions.length());
+  for (int i = 0; i < positions.length(); i++) {
+    elements->set(i, Smi::FromInt(positions[i]));
+  }
+  return Factory::NewJSArrayWithElements(elements);
+}
+
+
+// RegExp result cache.
+
+
+int RegExpResultCache::Hash(FixedArray* data, String* subject, int index) {
+  // Uses only lower 32 bits if pointers are larger.
+  uint32_t data_hash =
+      static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data)) >> 2;
+  uint32_t subject_hash =
+      static_cast<uint32_t>(reinterpret_cast<uintptr_t>(subject)) >> 2;
+  // Multiplicative hashing spreads the start indices of the matches in a
+  // subject, which tend to share their low bits, over the whole cache.
+  uint32_t hash = (data_hash ^ subject_hash ^ index) * 2654435761u;
+  return hash >> (32 - kLengthBits);
+}
+
+
+bool RegExpResultCache::Lookup(Handle<JSRegExp> regexp,
+                               Handle<String> subject,
+                               int index,
+                               Handle<JSArray> last_match_info,
+                               bool* matched) {
+  FixedArray* data = FixedArray::cast(regexp->data());
+  Entry& entry = entries_[Hash(data, *subject, index)];
+  if (entry.data != data || entry.subject != *subject || entry.index != index) {
+    return false;
+  }
+  if (entry.register_count == kNoMatch) {
+    *matched = false;
+    return true;
+  }
+  // Growing the last match info can cause a gc, which clears the entry.
+  int register_count = entry.register_count;
+  int registers[kMaxRegisters];
+  for (int i = 0; i < register_count; i++) registers[i] = entry.registers[i];
+  last_match_info->EnsureSize(register_count +
+                              RegExpImpl::kLastMatchOverhead);
+  {
+    NoHandleAllocation no_handles;
+    FixedArray* array = FixedArray::cast(last_match_info->elements());
+    for (int i = 0; i < register_count; i++) {
+      RegExpImpl::SetCapture(array, i, registers[i]);
+    }
+    RegExpImpl::SetLastCaptureCount(array, register_count);
+    RegExpImpl::SetLastSubject(array, *subject);
+    RegExpImpl::SetLastInput(array, *subject);
+  }
+  *matched = true;
+  return true;
+}
+
+
+void RegExpResultCache::Update(JSRegExp* regexp,
+                               String* subject,
+                               int index,
+                               JSArray* last_match_info,
+                               bool matched) {
+  FixedArray* data = FixedArray::cast(regexp->data());
+  Entry& entry = entries_[Hash(data, subject, index)];
+  if (matched) {
+    FixedArray* array = FixedArray::cast(last_match_info->elements());
+    int register_count = RegExpImpl::GetLastCaptureCount(array);
+    if (register_count > kMaxRegisters) return;
+    for (int i = 0; i < register_count; i++) {
+      entry.registers[i] = RegExpImpl::GetCapture(array, i);
+    }
+    entry.register_count = register_count;
+  } else {
+    entry.register_count = kNoMatch;
+  }
+  entry.data = data;
+  entry.subject = subject;
+  entry.index = index;
+}
+
+
+void RegExpResultCache::Clear() {
+  for (int index = 0; index < kLength; index++) entries_[index].data = NULL;
+}
+
+
+RegExpResultCache::Entry
+RegExpResultCache::entries_[RegExpResultCache::kLength];
+
+
 // RegExp Atom implementation: Simple string search using indexOf.
 
 
@@ -384,6 +543,127 @@ void RegExpImpl::IrregexpPrepare(Handle<JSRegExp> re,
 }
 
 
+// Finds the longest atom that every match of a regexp tree contains, and
+// the range of offsets from the start of the match it can occur at.
+class RequiredLiteralFinder {
+ public:
+  RequiredLiteralFinder() : min_offset_(0), max_offset_(0) { }
+  void Find(RegExpTree* tree) { Visit(tree, 0, 0); }
+  Vector<const uc16> literal() { return literal_; }
+  int min_offset() { return min_offset_; }
+  int max_offset() { return max_offset_; }
+
+ private:
+  void Visit(RegExpTree* tree, int min_offset, int max_offset);
+  void AddCandidate(Vector<const uc16> literal,
+                    int min_offset,
+                    int max_offset);
+  static int AddOffsets(int a, int b) {
+    if (a > RegExpTree::kInfinity - b) return RegExpTree::kInfinity;
+    return a + b;
+  }
+
+  Vector<const uc16> literal_;
+  int min_offset_;
+  int max_offset_;
+};
+
+
+void RequiredLiteralFinder::Visit(RegExpTree* tree,
+                                  int min_offset,
+                                  int max_offset) {
+  if (tree->IsAtom()) {
+    AddCandidate(tree->AsAtom()->data(), min_offset, max_offset);
+  } else if (tree->IsText()) {
+    ZoneList<TextElement>* elements = tree->AsText()->elements();
+    for (int i = 0; i < elements->length(); i++) {
+      TextElement elm = elements->at(i);
+      if (elm.type == TextElement::ATOM) {
+        AddCandidate(elm.data.u_atom->data(), min_offset, max_offset);
+      }
+      min_offset = AddOffsets(min_offset, elm.length());
+      max_offset = AddOffsets(max_offset, elm.length());
+    }
+  } else if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      RegExpTree* node = nodes->at(i);
+      Visit(node, min_offset, max_offset);
+      min_offset = AddOffsets(min_offset, node->min_match());
+      max_offset = AddOffsets(max_offset, node->max_match());
+    }
+  } else if (tree->IsCapture()) {
+    Visit(tree->AsCapture()->body(), min_offset, max_offset);
+  } else if (tree->IsQuantifier()) {
+    // The first repetition of the body is required if any are.
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->min() > 0) {
+      Visit(quantifier->body(), min_offset, max_offset);
+    }
+  }
+  // Disjunctions, lookaheads, assertions, back references and character
+  // classes contribute no required literal.
+}
+
+
+void RequiredLiteralFinder::AddCandidate(Vector<const uc16> literal,
+                                         int min_offset,
+                                         int max_offset) {
+  // Prefer the longest literal, and then the one whose position is known
+  // most precisely.
+  if (literal.length() < literal_.length()) return;
+  if (literal.length() == literal_.length() &&
+      max_offset - min_offset >= max_offset_ - min_offset_) {
+    return;
+  }
+  literal_ = literal;
+  min_offset_ = min_offset;
+  max_offset_ = max_offset;
+}
+
+
+void RegExpImpl::IrregexpSetRequiredLiteral(Handle<JSRegExp> re,
+                                            RegExpTree* tree) {
+  RequiredLiteralFinder finder;
+  finder.Find(tree);
+  if (finder.literal().length() == 0) return;
+  if (!Smi::IsValid(finder.min_offset())) return;
+  Handle<String> literal = Factory::NewStringFromTwoByte(finder.literal());
+  int max_offset = finder.max_offset();
+  if (max_offset == RegExpTree::kInfinity || !Smi::IsValid(max_offset)) {
+    max_offset = -1;
+  }
+  re->SetDataAt(JSRegExp::kIrregexpLiteralIndex, *literal);
+  re->SetDataAt(JSRegExp::kIrregexpLiteralMinOffsetIndex,
+                Smi::FromInt(finder.min_offset()));
+  re->SetDataAt(JSRegExp::kIrregexpLiteralMaxOffsetIndex,
+                Smi::FromInt(max_offset));
+}
+
+
+bool RegExpImpl::IrregexpSkipToRequiredLiteral(Handle<FixedArray> regexp,
+                                               Handle<String> subject,
+                                               int* index) {
+  Object* literal = regexp->get(JSRegExp::kIrregexpLiteralIndex);
+  if (!literal->IsString()) return true;
+  int min_offset =
+      Smi::cast(regexp->get(JSRegExp::kIrregexpLiteralMinOffsetIndex))->value();
+  int max_offset =
+      Smi::cast(regexp->get(JSRegExp::kIrregexpLiteralMaxOffsetIndex))->value();
+  // A match starting at the index has the literal at or after this position.
+  int from = *index + min_offset;
+  if (from > subject->length()) return false;
+  int found = Runtime::StringMatch(subject,
+                                   Handle<String>(String::cast(literal)),
+                                   from);
+  if (found < 0) return false;
+  if (max_offset >= 0 && found - max_offset > *index) {
+    *index = found - max_offset;
+  }
+  return true;
+}
+
+
 Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
                                         Handle<String> subject,
                                         int previous_index,
@@ -412,35 +692,39 @@ Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
 
   Handle<FixedArray> array;
 
-  // Dispatch to the correct RegExp implementation.
   Handle<FixedArray> regexp(FixedArray::cast(jsregexp->data()));
+  if (!IrregexpSkipToRequiredLiteral(regexp, subject, &previous_index)) {
+    return Factory::null_value();
+  }
+
+  // Dispatch to the correct RegExp implementation.
 #ifdef V8_NATIVE_REGEXP
-#if V8_TARGET_ARCH_IA32
+#if V8_TARGET_ARCH_IA32 || V8_TARGET_ARCH_X64
   OffsetsVector captures(number_of_capture_registers);
   int* captures_vector = captures.vector();
-  RegExpMacroAssemblerIA32::Result res;
+  NativeRegExpMacroAssembler::Result res;
   do {
     bool is_ascii = subject->IsAsciiRepresentation();
     if (!EnsureCompiledIrregexp(jsregexp, is_ascii)) {
       return Handle<Object>::null();
     }
     Handle<Code> code(RegExpImpl::IrregexpNativeCode(*regexp, is_ascii));
-    res = RegExpMacroAssemblerIA32::Match(code,
-                                          subject,
-                                          captures_vector,
-                                          captures.length(),
-                                          previous_index);
+    res = NativeRegExpMacroAssembler::Match(code,
+                                            subject,
+                                            captures_vector,
+                                            captures.length(),
+                                            previous_index);
     // If result is RETRY, the string have changed representation, and we
     // must restart from scratch.
-  } while (res == RegExpMacroAssemblerIA32::RETRY);
-  if (res == RegExpMacroAssemblerIA32::EXCEPTION) {
+  } while (res == NativeRegExpMacroAssembler::RETRY);
+  if (res == NativeRegExpMacroAssembler::EXCEPTION) {
     ASSERT(Top::has_pending_exception());
     return Handle<Object>::null();
   }
-  ASSERT(res == RegExpMacroAssemblerIA32::SUCCESS
-      || res == RegExpMacroAssemblerIA32::FAILURE);
+  ASSERT(res == NativeRegExpMacroAssembler::SUCCESS
+      || res == NativeRegExpMacroAssembler::FAILURE);
 
-  if (res != RegExpMacroAssemblerIA32::SUCCESS) return Factory::null_value();
+  if (res != NativeRegExpMacroAssembler::SUCCESS) return Factory::null_value();
 
   array = Handle<FixedArray>(FixedArray::cast(last_match_info->elements()));
   ASSERT(array->length() >= number_of_capture_registers + kLastMatchOverhead);
@@ -449,39 +733,49 @@ Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
     SetCapture(*array, i, captures_vector[i]);
     SetCapture(*array, i + 1, captures_vector[i + 1]);
   }
-#else  // !V8_TARGET_ARCH_IA32
+#else  // !V8_TARGET_ARCH_IA32 && !V8_TARGET_ARCH_X64
     UNREACHABLE();
-#endif  // V8_TARGET_ARCH_IA32
+#endif  // V8_TARGET_ARCH_IA32 || V8_TARGET_ARCH_X64
 #else  // !V8_NATIVE_REGEXP
-  bool is_ascii = subject->IsAsciiRepresentation();
-  if (!EnsureCompiledIrregexp(jsregexp, is_ascii)) {
+  IrregexpInterpreter::Result res;
+  do {
+    bool is_ascii = subject->IsAsciiRepresentation();
+    if (!EnsureCompiledIrregexp(jsregexp, is_ascii)) {
+      return Handle<Object>::null();
+    }
+    // Now that we have done EnsureCompiledIrregexp we can get the number of
+    // registers.
+    int number_of_registers =
+        IrregexpNumberOfRegisters(FixedArray::cast(jsregexp->data()));
+    OffsetsVector registers(number_of_registers);
+    int* register_vector = registers.vector();
+    for (int i = number_of_capture_registers - 1; i >= 0; i--) {
+      register_vector[i] = -1;
+    }
+    Handle<ByteArray> byte_codes(IrregexpByteCode(*regexp, is_ascii));
+
+    res = IrregexpInterpreter::Match(byte_codes,
+                                     subject,
+                                     register_vector,
+                                     previous_index);
+    if (res == IrregexpInterpreter::SUCCESS) {
+      array = Handle<FixedArray>(FixedArray::cast(last_match_info->elements()));
+      ASSERT(array->length() >=
+             number_of_capture_registers + kLastMatchOverhead);
+      // The captures come in (start, end+1) pairs.
+      for (int i = 0; i < number_of_capture_registers; i += 2) {
+        SetCapture(*array, i, register_vector[i]);
+        SetCapture(*array, i + 1, register_vector[i + 1]);
+      }
+    }
+    // If result is RETRY, the string changed representation while an
+    // interrupt was handled, and we must restart from scratch.
+  } while (res == IrregexpInterpreter::RETRY);
+  if (res == IrregexpInterpreter::EXCEPTION) {
+    ASSERT(Top::has_pending_exception());
     return Handle<Object>::null();
   }
-  // Now that we have done EnsureCompiledIrregexp we can get the number of
-  // registers.
-  int number_of_registers =
-      IrregexpNumberOfRegisters(FixedArray::cast(jsregexp->data()));
-  OffsetsVector registers(number_of_registers);
-  int* register_vector = registers.vector();
-  for (int i = number_of_capture_registers - 1; i >= 0; i--) {
-    register_vector[i] = -1;
-  }
-  Handle<ByteArray> byte_codes(IrregexpByteCode(*regexp, is_ascii));
-
-  if (!IrregexpInterpreter::Match(byte_codes,
-                                  subject,
-                                  register_vector,
-                                  previous_index)) {
-    return Factory::null_value();
-  }
-
-  array = Handle<FixedArray>(FixedArray::cast(last_match_info->elements()));
-  ASSERT(array->length() >= number_of_capture_registers + kLastMatchOverhead);
-  // The captures come in (start, end+1) pairs.
-  for (int i = 0; i < number_of_capture_registers; i += 2) {
-    SetCapture(*array, i, register_vector[i]);
-    SetCapture(*array, i + 1, register_vector[i + 1]);
-  }
+  if (res != IrregexpInterpreter::SUCCESS) return Factory::null_value();
 #endif  // V8_NATIVE_REGEXP
 
   SetLastCaptureCount(*array, number_of_capture_registers);
@@ -492,6 +786,14 @@ Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
 }
 
 
+void RegExpImpl::ThrowBacktrackLimitExceeded() {
+  Handle<Object> error =
+      Factory::NewRangeError("regexp_backtrack_limit",
+                             HandleVector<Object>(NULL, 0));
+  Top::Throw(*error);
+}
+
+
 // -------------------------------------------------------------------
 // Implementation of the Irregexp regular expression engine.
 //
@@ -1262,12 +1564,19 @@ static int GetCaseIndependentLetters(uc16 character,
     letters[0] = character;
     length = 1;
   }
-  if (!ascii_subject || character <= String::kMaxAsciiCharCode) {
+  if (!ascii_subject) {
     return length;
   }
-  // The standard requires that non-ASCII characters cannot have ASCII
-  // character codes in their equivalence class.
-  return 0;
+  // An ascii subject only holds Latin-1 characters, so drop the equivalents
+  // that cannot occur in it.  Some characters outside Latin-1 have a Latin-1
+  // equivalent (\u0178 and \u00ff for example).
+  int ascii_length = 0;
+  for (int i = 0; i < length; i++) {
+    if (letters[i] <= String::kMaxAsciiCharCodeU) {
+      letters[ascii_length++] = letters[i];
+    }
+  }
+  return ascii_length;
 }
 
 
@@ -1304,22 +1613,20 @@ static inline bool EmitAtomNonLetter(RegExpCompiler* compiler,
   unibrow::uchar chars[unibrow::Ecma262UnCanonicalize::kMaxWidth];
   int length = GetCaseIndependentLetters(c, ascii, chars);
   if (length < 1) {
-    // This can't match.  Must be an ASCII subject and a non-ASCII character.
-    // We do not need to do anything since the ASCII pass already handled this.
+    // This can't match.  Must be an ASCII subject and a character without
+    // a Latin-1 equivalent.  We do not need to do anything since the ASCII
+    // pass already handled this.
     return false;  // Bounds not checked.
   }
   bool checked = false;
   // We handle the length > 1 case in a later pass.
   if (length == 1) {
-    if (ascii && c > String::kMaxAsciiCharCodeU) {
-      // Can't match - see above.
-      return false;  // Bounds not checked.
-    }
     if (!preloaded) {
       macro_assembler->LoadCurrentCharacter(cp_offset, on_failure, check);
       checked = check;
     }
-    macro_assembler->CheckNotCharacter(c, on_failure);
+    // For an ASCII subject the only equivalent may differ from c.
+    macro_assembler->CheckNotCharacter(chars[0], on_failure);
   }
   return checked;
 }
@@ -1802,25 +2109,22 @@ void TextNode::GetQuickCheckDetails(QuickCheckDetails* details,
         QuickCheckDetails::Position* pos =
             details->positions(characters_filled_in);
         uc16 c = quarks[i];
-        if (c > char_mask) {
-          // If we expect a non-ASCII character from an ASCII string,
-          // there is no way we can match. Not even case independent
-          // matching can turn an ASCII character into non-ASCII or
-          // vice versa.
-          details->set_cannot_match();
-          pos->determines_perfectly = false;
-          return;
-        }
         if (compiler->ignore_case()) {
           unibrow::uchar chars[unibrow::Ecma262UnCanonicalize::kMaxWidth];
           int length = GetCaseIndependentLetters(c, compiler->ascii(), chars);
-          ASSERT(length != 0);  // Can only happen if c > char_mask (see above).
+          if (length == 0) {
+            // None of the case equivalents of the character fit in an
+            // ASCII string, so there is no way we can match.
+            details->set_cannot_match();
+            pos->determines_perfectly = false;
+            return;
+          }
           if (length == 1) {
             // This letter has no case equivalents, so it's nice and simple
             // and the mask-compare will determine definitely whether we have
             // a match at this character position.
             pos->mask = char_mask;
-            pos->value = c;
+            pos->value = chars[0];
             pos->determines_perfectly = true;
           } else {
             uint32_t common_bits = char_mask;
@@ -1842,6 +2146,13 @@ void TextNode::GetQuickCheckDetails(QuickCheckDetails* details,
             pos->value = bits;
           }
         } else {
+          if (c > char_mask) {
+            // If we expect a non-ASCII character from an ASCII string,
+            // there is no way we can match.
+            details->set_cannot_match();
+            pos->determines_perfectly = false;
+            return;
+          }
           // Don't ignore case.  Nice simple case where the mask-compare will
           // determine definitely whether we have a match at this character
           // position.
@@ -2224,12 +2535,110 @@ static void UpdateBoundsCheck(int index, int* checked_up_to) {
 }
 
 
+// The number of characters a case-independent atom is checked in at a time
+// by the masked chunk pass.  See CalculatePreloadCharacters.
+static int MaskedChunkLength(RegExpCompiler* compiler) {
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+  return compiler->ascii() ? 4 : 2;
+#else
+  return 1;
+#endif
+}
+
+
+// Characters without case equivalents and letters whose two case variants
+// differ in only one bit ('a' and 'A' for example) can be checked exactly
+// with a mask and compare.  Returns false for the other characters.
+static bool GetCaseIndependentMask(uc16 c,
+                                   bool ascii,
+                                   uint32_t* mask,
+                                   uint32_t* value) {
+  unibrow::uchar chars[unibrow::Ecma262UnCanonicalize::kMaxWidth];
+  int length = GetCaseIndependentLetters(c, ascii, chars);
+  uint32_t char_mask =
+      ascii ? String::kMaxAsciiCharCode : String::kMaxUC16CharCode;
+  if (length == 1) {
+    *mask = char_mask;
+    *value = chars[0];
+    return true;
+  }
+  if (length != 2) return false;
+  uint32_t differing_bits = chars[0] ^ chars[1];
+  if ((differing_bits & (differing_bits - 1)) != 0) return false;
+  *mask = char_mask ^ differing_bits;
+  *value = chars[0] & *mask;
+  return true;
+}
+
+
+// Computes a mask and value for checking the case-independent characters
+// quarks[from] to quarks[from + chunk - 1] with a single multi-character
+// load.  Characters are loaded little-endian, so the first character ends
+// up in the lowest bits.  Returns false if one of the characters can't be
+// checked that way or if the quick check has already determined all of them.
+static bool GetMaskedChunk(RegExpCompiler* compiler,
+                           Vector<const uc16> quarks,
+                           int from,
+                           int chunk,
+                           QuickCheckDetails* quick_check,
+                           int quick_check_offset,
+                           uint32_t* mask,
+                           uint32_t* value) {
+  bool ascii = compiler->ascii();
+  int char_shift = ascii ? 8 : 16;
+  bool determined = true;
+  *mask = 0;
+  *value = 0;
+  for (int k = 0; k < chunk; k++) {
+    uint32_t char_mask;
+    uint32_t char_value;
+    if (!GetCaseIndependentMask(quarks[from + k],
+                                ascii,
+                                &char_mask,
+                                &char_value)) {
+      return false;
+    }
+    *mask |= char_mask << (k * char_shift);
+    *value |= char_value << (k * char_shift);
+    if (!DeterminedAlready(quick_check, quick_check_offset + from + k)) {
+      determined = false;
+    }
+  }
+  return !determined;
+}
+
+
+// True if the masked chunk pass has checked the j'th character of the atom.
+static bool InMaskedChunk(RegExpCompiler* compiler,
+                          Vector<const uc16> quarks,
+                          int j,
+                          QuickCheckDetails* quick_check,
+                          int quick_check_offset) {
+  int chunk = MaskedChunkLength(compiler);
+  if (!compiler->ignore_case() || chunk < 2) return false;
+  int from = j - j % chunk;
+  if (from + chunk > quarks.length()) return false;
+  uint32_t mask;
+  uint32_t value;
+  return GetMaskedChunk(compiler,
+                        quarks,
+                        from,
+                        chunk,
+                        quick_check,
+                        quick_check_offset,
+                        &mask,
+                        &value);
+}
+
+
 // We call this repeatedly to generate code for each pass over the text node.
 // The passes are in increasing order of difficulty because we hope one
 // of the first passes will fail in which case we are saved the work of the
 // later passes.  for example for the case independent regexp /%[asdfghjkl]a/
 // we will check the '%' in the first pass, the case independent 'a' in the
-// second pass and the character class in the last pass.
+// second pass and the character class in the last pass.  Longer case
+// independent atoms like /keyword/i are mostly checked several characters at
+// a time with a mask and compare, before any of the single character passes.
 //
 // The passes are done from right to left, so for example to test for /bar/
 // we will first test for an 'r' with offset 2, then an 'a' with offset 1
@@ -2269,16 +2678,52 @@ void TextNode::TextEmitPass(RegExpCompiler* compiler,
     int cp_offset = trace->cp_offset() + elm.cp_offset;
     if (elm.type == TextElement::ATOM) {
       Vector<const uc16> quarks = elm.data.u_atom->data();
+      if (pass == MASKED_CHUNK_MATCH) {
+        int chunk = MaskedChunkLength(compiler);
+        if (preloaded || chunk < 2) continue;
+        for (int j = (quarks.length() / chunk - 1) * chunk;
+             j >= 0;
+             j -= chunk) {
+          uint32_t mask;
+          uint32_t value;
+          if (!GetMaskedChunk(compiler,
+                              quarks,
+                              j,
+                              chunk,
+                              quick_check,
+                              elm.cp_offset,
+                              &mask,
+                              &value)) {
+            continue;
+          }
+          int last_offset = cp_offset + j + chunk - 1;
+          assembler->LoadCurrentCharacter(cp_offset + j,
+                                          backtrack,
+                                          *checked_up_to < last_offset,
+                                          chunk);
+          assembler->CheckNotCharacterAfterAnd(value, mask, backtrack);
+          UpdateBoundsCheck(last_offset, checked_up_to);
+        }
+        continue;
+      }
       for (int j = preloaded ? 0 : quarks.length() - 1; j >= 0; j--) {
         if (first_element_checked && i == 0 && j == 0) continue;
         if (DeterminedAlready(quick_check, elm.cp_offset + j)) continue;
+        if (!preloaded &&
+            InMaskedChunk(compiler, quarks, j, quick_check, elm.cp_offset)) {
+          continue;
+        }
         EmitCharacterFunction* emit_function = NULL;
         switch (pass) {
           case NON_ASCII_MATCH:
             ASSERT(ascii);
             if (quarks[j] > String::kMaxAsciiCharCode) {
-              assembler->GoTo(backtrack);
-              return;
+              unibrow::uchar chars[unibrow::Ecma262UnCanonicalize::kMaxWidth];
+              if (!compiler->ignore_case() ||
+                  GetCaseIndependentLetters(quarks[j], true, chars) == 0) {
+                assembler->GoTo(backtrack);
+                return;
+              }
             }
             break;
           case NON_LETTER_CHARACTER_MATCH:
@@ -2339,7 +2784,9 @@ bool TextNode::SkipPass(int int_pass, bool ignore_case) {
   if (ignore_case) {
     return pass == SIMPLE_CHARACTER_MATCH;
   } else {
-    return pass == NON_LETTER_CHARACTER_MATCH || pass == CASE_CHARACTER_MATCH;
+    return pass == MASKED_CHUNK_MATCH ||
+           pass == NON_LETTER_CHARACTER_MATCH ||
+           pass == CASE_CHARACTER_MATCH;
   }
 }
 
@@ -4462,19 +4909,15 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(RegExpCompileData* data,
   // ARM native regexp not implemented yet.
   UNREACHABLE();
 #endif
-#ifdef V8_TARGET_ARCH_X64
-  // X64 native regexp not implemented yet.
-  UNREACHABLE();
-#endif
-#ifdef V8_TARGET_ARCH_IA32
-  RegExpMacroAssemblerIA32::Mode mode;
+#if V8_TARGET_ARCH_IA32 || V8_TARGET_ARCH_X64
+  NativeRegExpMacroAssembler::Mode mode;
   if (is_ascii) {
-    mode = RegExpMacroAssemblerIA32::ASCII;
+    mode = NativeRegExpMacroAssembler::ASCII;
   } else {
-    mode = RegExpMacroAssemblerIA32::UC16;
+    mode = NativeRegExpMacroAssembler::UC16;
   }
-  RegExpMacroAssemblerIA32 macro_assembler(mode,
-                                           (data->capture_count + 1) * 2);
+  NativeRegExpMacroAssembler macro_assembler(mode,
+                                             (data->capture_count + 1) * 2);
   return compiler.Assemble(&macro_assembler,
                            node,
                            data->capture_count,
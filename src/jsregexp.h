@@ -33,6 +33,7 @@ namespace internal {
 
 
 class RegExpMacroAssembler;
+class RegExpTree;
 
 
 class RegExpImpl {
@@ -74,7 +75,10 @@ class RegExpImpl {
                              Handle<JSArray> lastMatchInfo);
 
   // Call RegExp.prototyp.exec(string) in a loop.
-  // Used by String.prototype.match and String.prototype.replace.
+  // On a match, the result is a JSArray holding the capture positions of
+  // all the matches one after the other, and lastMatchInfo describes the
+  // last of them. Otherwise the result is the null value.
+  // Used by String.prototype.replace with a replacement function.
   // This function calls the garbage collector if necessary.
   static Handle<Object> ExecGlobal(Handle<JSRegExp> regexp,
                                    Handle<String> subject,
@@ -106,6 +110,10 @@ class RegExpImpl {
                                      int index,
                                      Handle<JSArray> lastMatchInfo);
 
+  // Throws the exception for a match that has backtracked more than
+  // --regexp-backtrack-limit times.  Called by the regexp engines.
+  static void ThrowBacktrackLimitExceeded();
+
   // Offsets in the lastMatchInfo array.
   static const int kLastCaptureCount = 0;
   static const int kLastSubject = 1;
@@ -153,6 +161,16 @@ class RegExpImpl {
   static bool CompileIrregexp(Handle<JSRegExp> re, bool is_ascii);
   static inline bool EnsureCompiledIrregexp(Handle<JSRegExp> re, bool is_ascii);
 
+  // Records the longest literal string that every match of the tree
+  // contains, if any, in the regexp data.
+  static void IrregexpSetRequiredLiteral(Handle<JSRegExp> re,
+                                         RegExpTree* tree);
+  // Moves the index forward to the first position a match could start at,
+  // going by the required literal.  Returns false if no match is possible.
+  static bool IrregexpSkipToRequiredLiteral(Handle<FixedArray> regexp,
+                                            Handle<String> subject,
+                                            int* index);
+
 
   // Set the subject cache.  The previous string buffer is not deleted, so the
   // caller should ensure that it doesn't leak.
@@ -172,6 +190,52 @@ class RegExpImpl {
 };
 
 
+// Cache for the results of RegExpImpl::Exec, keyed by the regexp data, the
+// subject string and the start index.  Both matches and failures to match
+// are cached.  The keys are raw heap pointers, so the cache is cleared at
+// startup and prior to any gc.
+class RegExpResultCache : public AllStatic {
+ public:
+  // Looks up the result of matching the regexp against the subject from the
+  // index.  On a hit *matched tells whether there was a match, and if there
+  // was its captures have been copied into the last match info.
+  // This function calls the garbage collector if necessary.
+  static bool Lookup(Handle<JSRegExp> regexp,
+                     Handle<String> subject,
+                     int index,
+                     Handle<JSArray> last_match_info,
+                     bool* matched);
+
+  // Records the result of an Exec.  For a match the captures are taken from
+  // the last match info.
+  static void Update(JSRegExp* regexp,
+                     String* subject,
+                     int index,
+                     JSArray* last_match_info,
+                     bool matched);
+
+  // Clear the cache.
+  static void Clear();
+
+ private:
+  static inline int Hash(FixedArray* data, String* subject, int index);
+  static const int kLengthBits = 8;
+  static const int kLength = 1 << kLengthBits;
+  // Matches with more capture registers than this are not cached.
+  static const int kMaxRegisters = 12;
+  static const int kNoMatch = -1;
+  struct Entry {
+    FixedArray* data;
+    String* subject;
+    int index;
+    // The number of capture registers, or kNoMatch.
+    int register_count;
+    int registers[kMaxRegisters];
+  };
+  static Entry entries_[kLength];
+};
+
+
 class CharacterRange {
  public:
   CharacterRange() : from_(0), to_(0) { }
@@ -816,6 +880,7 @@ class TextNode: public SeqRegExpNode {
   enum TextEmitPassType {
     NON_ASCII_MATCH,             // Check for characters that can't match.
     SIMPLE_CHARACTER_MATCH,      // Case-dependent single character check.
+    MASKED_CHUNK_MATCH,          // Case-independent multi-character check.
     NON_LETTER_CHARACTER_MATCH,  // Check characters that have no case equivs.
     CASE_CHARACTER_MATCH,        // Case-independent single character check.
     CHARACTER_CLASS_MATCH        // Character class.
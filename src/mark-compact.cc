@@ -206,6 +206,30 @@ void MarkCompactCollector::Finish() {
 static MarkingStack marking_stack;
 
 
+// Sliced strings are not allowed to keep an otherwise dead buffer alive
+// forever.  Marked sliced strings are recorded instead of having their
+// buffer visited, and the buffers are only marked once everything else
+// reachable has been marked (see MarkSlicedStringBuffers).  Sliced strings
+// whose buffer was not reachable in any other way are remembered so they
+// can be given a buffer of their own after the collection.
+static List<HeapObject*> marked_sliced_strings(0);
+static List<Object*> sliced_strings_to_trim(0);
+
+
+void MarkCompactCollector::IterateMarkedObjectBody(HeapObject* object,
+                                                   Map* map,
+                                                   ObjectVisitor* visitor) {
+  InstanceType type = map->instance_type();
+  if (FLAG_trim_sliced_strings &&
+      (type & kIsNotStringMask) == kStringTag &&
+      (type & kStringRepresentationMask) == kSlicedStringTag) {
+    marked_sliced_strings.Add(object);
+    return;
+  }
+  object->IterateBody(type, object->SizeFromMap(map), visitor);
+}
+
+
 static inline HeapObject* ShortCircuitConsString(Object** p) {
   // Optimization: If the heap object pointed to by p is a non-symbol
   // cons string whose right substring is Heap::empty_string, update
@@ -324,7 +348,7 @@ class MarkingVisitor : public ObjectVisitor {
     MarkCompactCollector::SetMark(obj);
     // Mark the map pointer and the body.
     MarkCompactCollector::MarkObject(map);
-    obj->IterateBody(map->instance_type(), obj->SizeFromMap(map), this);
+    MarkCompactCollector::IterateMarkedObjectBody(obj, map, this);
   }
 
   // Visit all unmarked objects pointed to by [start, end).
@@ -374,8 +398,8 @@ class RootMarkingVisitor : public ObjectVisitor {
     MarkCompactCollector::SetMark(object);
     // Mark the map pointer and body, and push them on the marking stack.
     MarkCompactCollector::MarkObject(map);
-    object->IterateBody(map->instance_type(), object->SizeFromMap(map),
-                        &stack_visitor_);
+    MarkCompactCollector::IterateMarkedObjectBody(object, map,
+                                                  &stack_visitor_);
 
     // Mark all the objects reachable from the map and body.  May leave
     // overflowed objects in the heap.
@@ -677,8 +701,7 @@ void MarkCompactCollector::EmptyMarkingStack(MarkingVisitor* visitor) {
     map_word.ClearMark();
     Map* map = map_word.ToMap();
     MarkObject(map);
-    object->IterateBody(map->instance_type(), object->SizeFromMap(map),
-                        visitor);
+    IterateMarkedObjectBody(object, map, visitor);
   }
 }
 
@@ -737,14 +760,38 @@ void MarkCompactCollector::ProcessMarkingStack(MarkingVisitor* visitor) {
 }
 
 
+void MarkCompactCollector::MarkSlicedStringBuffers() {
+  // Record all sliced strings with an unmarked buffer before marking any
+  // buffer, so that every slice sharing a dead buffer gets trimmed.
+  for (int i = 0; i < marked_sliced_strings.length(); i++) {
+    HeapObject* sliced = marked_sliced_strings[i];
+    Object* buffer =
+        *HeapObject::RawField(sliced, SlicedString::kBufferOffset);
+    if (!HeapObject::cast(buffer)->IsMarked()) {
+      sliced_strings_to_trim.Add(sliced);
+    }
+  }
+  for (int i = 0; i < marked_sliced_strings.length(); i++) {
+    HeapObject* sliced = marked_sliced_strings[i];
+    MarkObject(HeapObject::cast(
+        *HeapObject::RawField(sliced, SlicedString::kBufferOffset)));
+  }
+  marked_sliced_strings.Clear();
+}
+
+
 void MarkCompactCollector::ProcessObjectGroups(MarkingVisitor* visitor) {
   bool work_to_do = true;
   ASSERT(marking_stack.is_empty());
   while (work_to_do) {
     MarkObjectGroups();
+    // Only when the object groups are done is it known which sliced
+    // string buffers are unreachable from anywhere else.
+    if (marking_stack.is_empty()) MarkSlicedStringBuffers();
     work_to_do = !marking_stack.is_empty();
     ProcessMarkingStack(visitor);
   }
+  ASSERT(marked_sliced_strings.is_empty());
 }
 
 
@@ -800,6 +847,44 @@ void MarkCompactCollector::MarkLiveObjects() {
 }
 
 
+void MarkCompactCollector::TrimSlicedStrings() {
+  // A sliced string that covers most of its buffer is left alone: the copy
+  // would cost about as much memory as it frees.
+  static const int kMinBufferToSliceRatio = 2;
+  for (int i = 0; i < sliced_strings_to_trim.length(); i++) {
+    SlicedString* sliced = SlicedString::cast(sliced_strings_to_trim[i]);
+    String* buffer = sliced->buffer();
+    int length = sliced->length();
+    if (length * kMinBufferToSliceRatio > buffer->length()) continue;
+
+    int start = sliced->start();
+    Object* result;
+    if (buffer->IsAsciiRepresentation()) {
+      result = Heap::AllocateRawAsciiString(length, TENURED);
+      if (result->IsFailure()) break;
+      String::WriteToFlat(buffer,
+                          SeqAsciiString::cast(result)->GetChars(),
+                          start,
+                          start + length);
+    } else {
+      result = Heap::AllocateRawTwoByteString(length, TENURED);
+      if (result->IsFailure()) break;
+      String::WriteToFlat(buffer,
+                          SeqTwoByteString::cast(result)->GetChars(),
+                          start,
+                          start + length);
+    }
+    // The sliced string keeps its identity and hash; only the characters
+    // it refers to move.
+    sliced->set_buffer(String::cast(result));
+    sliced->set_start(0);
+    Counters::sliced_strings_trimmed.Increment();
+  }
+  // Remaining buffers stay alive until the next full collection.
+  sliced_strings_to_trim.Clear();
+}
+
+
 static int CountMarkedCallback(HeapObject* obj) {
   MapWord map_word = obj->map_word();
   map_word.ClearMark();
@@ -1465,6 +1550,11 @@ void MarkCompactCollector::UpdatePointers() {
   UpdatingVisitor updating_visitor;
   Heap::IterateRoots(&updating_visitor);
   GlobalHandles::IterateWeakRoots(&updating_visitor);
+  if (!sliced_strings_to_trim.is_empty()) {
+    Vector<Object*> slices = sliced_strings_to_trim.ToVector();
+    updating_visitor.VisitPointers(slices.start(),
+                                   slices.start() + slices.length());
+  }
 
   int live_maps = IterateLiveObjects(Heap::map_space(),
                                      &UpdatePointersInOldObject);
@@ -92,6 +92,12 @@ class MarkCompactCollector: public AllStatic {
   // completed full GC (expected to be zero).
   static int previous_marked_count() { return previous_marked_count_; }
 
+  // Gives the sliced strings whose buffers were reachable only through
+  // sliced strings during the last full GC flat buffers of their own, so
+  // that the old buffers can be reclaimed by the next one.  Allocates, so
+  // it is called by the heap once the collection itself is over.
+  static void TrimSlicedStrings();
+
   // During a full GC, there is a stack-allocated GCTracer that is used for
   // bookkeeping information.  Return a pointer to that tracer.
   static GCTracer* tracer() { return tracer_; }
@@ -153,6 +159,13 @@ class MarkCompactCollector: public AllStatic {
     if (!obj->IsMarked()) MarkUnmarkedObject(obj);
   }
 
+  // Visit the body of a marked object.  The buffer of a sliced string is
+  // not visited; the sliced string is recorded for MarkSlicedStringBuffers
+  // instead.
+  static void IterateMarkedObjectBody(HeapObject* object,
+                                      Map* map,
+                                      ObjectVisitor* visitor);
+
   static inline void SetMark(HeapObject* obj) {
     tracer_->increment_marked_count();
 #ifdef DEBUG
@@ -183,9 +196,14 @@ class MarkCompactCollector: public AllStatic {
   // group marked.
   static void MarkObjectGroups();
 
+  // Mark the buffers of the recorded sliced strings, remembering the
+  // sliced strings whose buffer was not marked yet for trimming.
+  static void MarkSlicedStringBuffers();
+
   // Mark all objects in an object group with at least one marked
   // object, then all objects reachable from marked objects in object
-  // groups, and repeat.
+  // groups, and repeat.  Once no object group is left to mark, the
+  // buffers of sliced strings are marked the same way.
   static void ProcessObjectGroups(MarkingVisitor* visitor);
 
   // Mark objects reachable (transitively) from objects in the marking stack
@@ -96,6 +96,7 @@ const kMessages = {
   // RangeError
   invalid_array_length:         "Invalid array length",
   stack_overflow:               "Maximum call stack size exceeded",
+  regexp_backtrack_limit:       "Maximum regular expression backtrack count exceeded",
   apply_overflow:               "Function.prototype.apply cannot support %0 arguments",
   // SyntaxError
   unable_to_parse:              "Parse error",
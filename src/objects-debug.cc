@@ -619,6 +619,7 @@ void SharedFunctionInfo::SharedFunctionInfoPrint() {
   PrintF("\n - debug info = ");
   debug_info()->ShortPrint();
   PrintF("\n - length = %d", length());
+  PrintF("\n - hotness count = %d", hotness_count());
   PrintF("\n");
 }
 
@@ -766,6 +767,10 @@ void JSRegExp::JSRegExpVerify() {
           || (is_native ? uc16_data->IsCode() : uc16_data->IsByteArray()));
       ASSERT(arr->get(JSRegExp::kIrregexpCaptureCountIndex)->IsSmi());
       ASSERT(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)->IsSmi());
+      Object* literal = arr->get(JSRegExp::kIrregexpLiteralIndex);
+      ASSERT(literal->IsUndefined() || literal->IsString());
+      ASSERT(arr->get(JSRegExp::kIrregexpLiteralMinOffsetIndex)->IsSmi());
+      ASSERT(arr->get(JSRegExp::kIrregexpLiteralMaxOffsetIndex)->IsSmi());
       break;
     }
     default:
@@ -1593,6 +1593,13 @@ Object* String::TryFlattenIfNotFlat() {
 }
 
 
+Vector<const byte> String::ToOneByteVector() {
+  Vector<const char> chars = ToAsciiVector();
+  return Vector<const byte>(reinterpret_cast<const byte*>(chars.start()),
+                            chars.length());
+}
+
+
 uint16_t String::Get(int index) {
   ASSERT(index >= 0 && index < length());
   switch (StringShape(this).full_representation_tag()) {
@@ -2300,6 +2307,7 @@ INT_ACCESSORS(SharedFunctionInfo, start_position_and_type,
 INT_ACCESSORS(SharedFunctionInfo, end_position, kEndPositionOffset)
 INT_ACCESSORS(SharedFunctionInfo, function_token_position,
               kFunctionTokenPositionOffset)
+SMI_ACCESSORS(SharedFunctionInfo, hotness_count, kHotnessCountOffset)
 
 
 void SharedFunctionInfo::DontAdaptArguments() {
@@ -3468,12 +3468,20 @@ bool String::LooksValid() {
 
 
 int String::Utf8Length() {
-  if (IsAsciiRepresentation()) return length();
   // Attempt to flatten before accessing the string.  It probably
   // doesn't make Utf8Length faster, but it is very likely that
   // the string will be accessed later (for example by WriteUtf8)
   // so it's still a good idea.
   TryFlattenIfNotFlat();
+  if (IsAsciiRepresentation() && IsFlat()) {
+    // Latin-1 characters above 0x7f take two bytes in UTF-8.
+    Vector<const byte> chars = ToOneByteVector();
+    int result = chars.length();
+    for (int i = 0; i < chars.length(); i++) {
+      if (chars[i] > unibrow::Utf8::kMaxOneByteChar) result++;
+    }
+    return result;
+  }
   Access<StringInputBuffer> buffer(&string_input_buffer);
   buffer->Reset(0, this);
   int result = 0;
@@ -3675,7 +3683,7 @@ void SeqTwoByteString::SeqTwoByteStringReadBlockIntoBuffer(ReadBlockBuffer* rbb,
     uint16_t c = *reinterpret_cast<uint16_t*>(
         reinterpret_cast<char*>(this) -
             kHeapObjectTag + kHeaderSize + offset * kShortSize);
-    if (c <= kMaxAsciiCharCode) {
+    if (c <= unibrow::Utf8::kMaxOneByteChar) {
       // Fast case for ASCII characters.   Cursor is an input output argument.
       if (!unibrow::CharacterStream::EncodeAsciiCharacter(c,
                                                           rbb->util_buffer,
@@ -3699,14 +3707,51 @@ void SeqTwoByteString::SeqTwoByteStringReadBlockIntoBuffer(ReadBlockBuffer* rbb,
 }
 
 
+// The character stream encoding only passes characters up to 0x7f through
+// unchanged, so the Latin-1 characters of ascii strings cannot be handed
+// out directly.  Returns the length of the prefix that can.
+static unsigned SevenBitPrefixLength(const unibrow::byte* chars,
+                                     unsigned length) {
+  for (unsigned i = 0; i < length; i++) {
+    if (chars[i] > unibrow::Utf8::kMaxOneByteChar) return i;
+  }
+  return length;
+}
+
+
+void String::OneByteReadBlockIntoBuffer(const unibrow::byte* chars,
+                                        ReadBlockBuffer* rbb,
+                                        unsigned* offset_ptr,
+                                        unsigned max_chars) {
+  unsigned capacity = rbb->capacity - rbb->cursor;
+  unsigned prefix =
+      SevenBitPrefixLength(chars, max_chars > capacity ? capacity : max_chars);
+  memcpy(rbb->util_buffer + rbb->cursor, chars, prefix);
+  rbb->cursor += prefix;
+  unsigned chars_read = prefix;
+  while (chars_read < max_chars) {
+    if (!unibrow::CharacterStream::EncodeCharacter(chars[chars_read],
+                                                   rbb->util_buffer,
+                                                   rbb->capacity,
+                                                   rbb->cursor)) {
+      break;
+    }
+    chars_read++;
+  }
+  rbb->remaining += chars_read;
+  *offset_ptr += chars_read;
+}
+
+
 const unibrow::byte* SeqAsciiString::SeqAsciiStringReadBlock(
     unsigned* remaining,
     unsigned* offset_ptr,
     unsigned max_chars) {
   const unibrow::byte* b = reinterpret_cast<unibrow::byte*>(this) -
       kHeapObjectTag + kHeaderSize + *offset_ptr * kCharSize;
-  *remaining = max_chars;
-  *offset_ptr += max_chars;
+  unsigned length = SevenBitPrefixLength(b, max_chars);
+  *remaining = length;
+  *offset_ptr += length;
   return b;
 }
 
@@ -3801,7 +3846,7 @@ const unibrow::byte* SlicedString::SlicedStringReadBlock(ReadBlockBuffer* rbb,
 
 uint16_t ExternalAsciiString::ExternalAsciiStringGet(int index) {
   ASSERT(index >= 0 && index < length());
-  return resource()->data()[index];
+  return static_cast<byte>(resource()->data()[index]);
 }
 
 
@@ -3812,8 +3857,9 @@ const unibrow::byte* ExternalAsciiString::ExternalAsciiStringReadBlock(
   // Cast const char* to unibrow::byte* (signedness difference).
   const unibrow::byte* b =
       reinterpret_cast<const unibrow::byte*>(resource()->data()) + *offset_ptr;
-  *remaining = max_chars;
-  *offset_ptr += max_chars;
+  unsigned length = SevenBitPrefixLength(b, max_chars);
+  *remaining = length;
+  *offset_ptr += length;
   return b;
 }
 
@@ -3839,7 +3885,7 @@ void ExternalTwoByteString::ExternalTwoByteStringReadBlockIntoBuffer(
   const uint16_t* data = resource()->data();
   while (chars_read < max_chars) {
     uint16_t c = data[offset];
-    if (c <= kMaxAsciiCharCode) {
+    if (c <= unibrow::Utf8::kMaxOneByteChar) {
       // Fast case for ASCII characters. Cursor is an input output argument.
       if (!unibrow::CharacterStream::EncodeAsciiCharacter(c,
                                                           rbb->util_buffer,
@@ -3864,15 +3910,9 @@ void ExternalTwoByteString::ExternalTwoByteStringReadBlockIntoBuffer(
 void SeqAsciiString::SeqAsciiStringReadBlockIntoBuffer(ReadBlockBuffer* rbb,
                                                  unsigned* offset_ptr,
                                                  unsigned max_chars) {
-  unsigned capacity = rbb->capacity - rbb->cursor;
-  if (max_chars > capacity) max_chars = capacity;
-  memcpy(rbb->util_buffer + rbb->cursor,
-         reinterpret_cast<char*>(this) - kHeapObjectTag + kHeaderSize +
-             *offset_ptr * kCharSize,
-         max_chars);
-  rbb->remaining += max_chars;
-  *offset_ptr += max_chars;
-  rbb->cursor += max_chars;
+  const unibrow::byte* b = reinterpret_cast<unibrow::byte*>(this) -
+      kHeapObjectTag + kHeaderSize + *offset_ptr * kCharSize;
+  OneByteReadBlockIntoBuffer(b, rbb, offset_ptr, max_chars);
 }
 
 
@@ -3880,14 +3920,9 @@ void ExternalAsciiString::ExternalAsciiStringReadBlockIntoBuffer(
       ReadBlockBuffer* rbb,
       unsigned* offset_ptr,
       unsigned max_chars) {
-  unsigned capacity = rbb->capacity - rbb->cursor;
-  if (max_chars > capacity) max_chars = capacity;
-  memcpy(rbb->util_buffer + rbb->cursor,
-         resource()->data() + *offset_ptr,
-         max_chars);
-  rbb->remaining += max_chars;
-  *offset_ptr += max_chars;
-  rbb->cursor += max_chars;
+  const unibrow::byte* b =
+      reinterpret_cast<const unibrow::byte*>(resource()->data()) + *offset_ptr;
+  OneByteReadBlockIntoBuffer(b, rbb, offset_ptr, max_chars);
 }
 
 
@@ -3908,9 +3943,14 @@ const unibrow::byte* String::ReadBlock(String* input,
     case kSeqStringTag:
       if (input->IsAsciiRepresentation()) {
         SeqAsciiString* str = SeqAsciiString::cast(input);
-        return str->SeqAsciiStringReadBlock(&rbb->remaining,
-                                            offset_ptr,
-                                            max_chars);
+        const unibrow::byte* answer =
+            str->SeqAsciiStringReadBlock(&rbb->remaining,
+                                         offset_ptr,
+                                         max_chars);
+        if (rbb->remaining > 0) return answer;
+        // The block starts with a Latin-1 character that has to be encoded.
+        str->SeqAsciiStringReadBlockIntoBuffer(rbb, offset_ptr, max_chars);
+        return rbb->util_buffer;
       } else {
         SeqTwoByteString* str = SeqTwoByteString::cast(input);
         str->SeqTwoByteStringReadBlockIntoBuffer(rbb,
@@ -3928,10 +3968,14 @@ const unibrow::byte* String::ReadBlock(String* input,
                                                               max_chars);
     case kExternalStringTag:
       if (input->IsAsciiRepresentation()) {
-        return ExternalAsciiString::cast(input)->ExternalAsciiStringReadBlock(
-            &rbb->remaining,
-            offset_ptr,
-            max_chars);
+        ExternalAsciiString* str = ExternalAsciiString::cast(input);
+        const unibrow::byte* answer =
+            str->ExternalAsciiStringReadBlock(&rbb->remaining,
+                                              offset_ptr,
+                                              max_chars);
+        if (rbb->remaining > 0) return answer;
+        str->ExternalAsciiStringReadBlockIntoBuffer(rbb, offset_ptr, max_chars);
+        return rbb->util_buffer;
       } else {
         ExternalTwoByteString::cast(input)->
             ExternalTwoByteStringReadBlockIntoBuffer(rbb,
@@ -4223,8 +4267,11 @@ void String::WriteToFlat(String* src,
     ASSERT(0 <= from && from <= to && to <= source->length());
     switch (StringShape(source).full_representation_tag()) {
       case kAsciiStringTag | kExternalStringTag: {
+        // Ascii characters are copied as unsigned Latin-1 codes.
+        const byte* data = reinterpret_cast<const byte*>(
+            ExternalAsciiString::cast(source)->resource()->data());
         CopyChars(sink,
-                  ExternalAsciiString::cast(source)->resource()->data() + from,
+                  data + from,
                   to - from);
         return;
       }
@@ -4237,8 +4284,10 @@ void String::WriteToFlat(String* src,
         return;
       }
       case kAsciiStringTag | kSeqStringTag: {
+        const byte* data = reinterpret_cast<const byte*>(
+            SeqAsciiString::cast(source)->GetChars());
         CopyChars(sink,
-                  SeqAsciiString::cast(source)->GetChars() + from,
+                  data + from,
                   to - from);
         return;
       }
@@ -4367,7 +4416,7 @@ template <typename IteratorA>
 static inline bool CompareStringContentsPartial(IteratorA* ia, String* b) {
   if (b->IsFlat()) {
     if (b->IsAsciiRepresentation()) {
-      VectorIterator<char> ib(b->ToAsciiVector());
+      VectorIterator<byte> ib(b->ToOneByteVector());
       return CompareStringContents(ia, &ib);
     } else {
       VectorIterator<uc16> ib(b->ToUC16Vector());
@@ -4411,12 +4460,12 @@ bool String::SlowEquals(String* other) {
           Vector<const char> vec2 = other->ToAsciiVector();
           return CompareRawStringContents(vec1, vec2);
         } else {
-          VectorIterator<char> buf1(vec1);
+          VectorIterator<byte> buf1(this->ToOneByteVector());
           VectorIterator<uc16> ib(other->ToUC16Vector());
           return CompareStringContents(&buf1, &ib);
         }
       } else {
-        VectorIterator<char> buf1(vec1);
+        VectorIterator<byte> buf1(this->ToOneByteVector());
         string_compare_buffer_b.Reset(0, other);
         return CompareStringContents(&buf1, &string_compare_buffer_b);
       }
@@ -4425,7 +4474,7 @@ bool String::SlowEquals(String* other) {
       if (other->IsFlat()) {
         if (other->IsAsciiRepresentation()) {
           VectorIterator<uc16> buf1(vec1);
-          VectorIterator<char> ib(other->ToAsciiVector());
+          VectorIterator<byte> ib(other->ToOneByteVector());
           return CompareStringContents(&buf1, &ib);
         } else {
           Vector<const uc16> vec2(other->ToUC16Vector());
@@ -5015,6 +5064,17 @@ void Code::CopyFrom(const CodeDesc& desc) {
 }
 
 
+Map* Code::FindFirstMap() {
+  for (RelocIterator it(this, RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT));
+       !it.done();
+       it.next()) {
+    Object* object = it.rinfo()->target_object();
+    if (object->IsMap()) return Map::cast(object);
+  }
+  return NULL;
+}
+
+
 // Locate the source position which is closest to the address in the code. This
 // is using the source position information embedded in the relocation info.
 // The position returned is relative to the beginning of the script where the
@@ -5094,6 +5154,7 @@ const char* Code::ICState2String(InlineCacheState state) {
     case PREMONOMORPHIC: return "PREMONOMORPHIC";
     case MONOMORPHIC: return "MONOMORPHIC";
     case MONOMORPHIC_PROTOTYPE_FAILURE: return "MONOMORPHIC_PROTOTYPE_FAILURE";
+    case POLYMORPHIC: return "POLYMORPHIC";
     case MEGAMORPHIC: return "MEGAMORPHIC";
     case DEBUG_BREAK: return "DEBUG_BREAK";
     case DEBUG_PREPARE_STEP_IN: return "DEBUG_PREPARE_STEP_IN";
@@ -2602,6 +2602,11 @@ class Code: public HeapObject {
   // Convert inline cache target from code object to address after GC
   void ConvertICTargetsFromObjectToAddress();
 
+  // Returns the first map embedded in the code, or NULL if there is
+  // none.  For most monomorphic inline cache stubs this is the map of
+  // the receiver.
+  Map* FindFirstMap();
+
   // Relocate the code by delta bytes. Called to signal that this code
   // object has been moved by delta bytes.
   void Relocate(int delta);
@@ -3081,6 +3086,12 @@ class SharedFunctionInfo: public HeapObject {
   inline bool is_toplevel();
   inline void set_is_toplevel(bool value);
 
+  // [hotness count]: Number of calls and loop iterations left before
+  // the function is recompiled by the optimizing compiler.  Counted
+  // down by the generated code.
+  inline int hotness_count();
+  inline void set_hotness_count(int value);
+
   // [source code]: Source code for the function.
   bool HasSourceCode();
   Object* GetSourceCode();
@@ -3120,7 +3131,8 @@ class SharedFunctionInfo: public HeapObject {
   static const int kScriptOffset = kExternalReferenceDataOffset + kPointerSize;
   static const int kDebugInfoOffset = kScriptOffset + kPointerSize;
   static const int kInferredNameOffset = kDebugInfoOffset + kPointerSize;
-  static const int kSize = kInferredNameOffset + kPointerSize;
+  static const int kHotnessCountOffset = kInferredNameOffset + kPointerSize;
+  static const int kSize = kHotnessCountOffset + kPointerSize;
 
  private:
   // Bit positions in length_and_flg.
@@ -3468,8 +3480,14 @@ class JSRegExp: public JSObject {
   static const int kIrregexpMaxRegisterCountIndex = kDataIndex + 2;
   // Number of captures in the compiled regexp.
   static const int kIrregexpCaptureCountIndex = kDataIndex + 3;
-
-  static const int kIrregexpDataSize = kIrregexpCaptureCountIndex + 1;
+  // A string that every match contains, or undefined.
+  static const int kIrregexpLiteralIndex = kDataIndex + 4;
+  // The range of offsets from the start of a match at which the literal
+  // occurs.  The maximal offset is -1 if it is unbounded.
+  static const int kIrregexpLiteralMinOffsetIndex = kDataIndex + 5;
+  static const int kIrregexpLiteralMaxOffsetIndex = kDataIndex + 6;
+
+  static const int kIrregexpDataSize = kIrregexpLiteralMaxOffsetIndex + 1;
 };
 
 
@@ -3630,6 +3648,8 @@ class String: public HeapObject {
   inline uint32_t length_field();
   inline void set_length_field(uint32_t value);
 
+  // One-byte ("ascii") strings hold Latin-1 characters, i.e. every
+  // character code up to kMaxAsciiCharCode.
   inline bool IsAsciiRepresentation();
   inline bool IsTwoByteRepresentation();
 
@@ -3653,6 +3673,8 @@ class String: public HeapObject {
 
   Vector<const char> ToAsciiVector();
   Vector<const uc16> ToUC16Vector();
+  // The characters of a flat ascii string as unsigned Latin-1 codes.
+  inline Vector<const byte> ToOneByteVector();
 
   // Mark the string as an undetectable object. It only applies to
   // ascii and two byte string types.
@@ -3741,9 +3763,9 @@ class String: public HeapObject {
 
   static const int kMaxArrayIndexSize = 10;
 
-  // Max ascii char code.
-  static const int kMaxAsciiCharCode = unibrow::Utf8::kMaxOneByteChar;
-  static const unsigned kMaxAsciiCharCodeU = unibrow::Utf8::kMaxOneByteChar;
+  // Max char code that fits in an ascii (one-byte, Latin-1) string.
+  static const int kMaxAsciiCharCode = 0xff;
+  static const unsigned kMaxAsciiCharCodeU = 0xff;
   static const int kMaxUC16CharCode = 0xffff;
 
   // Minimum length for a cons or sliced string.
@@ -3827,6 +3849,12 @@ class String: public HeapObject {
                                   ReadBlockBuffer* buffer,
                                   unsigned* offset_ptr,
                                   unsigned max_chars);
+  // Copies the characters of a one-byte string, encoding the Latin-1
+  // characters that the character stream cannot pass through as bytes.
+  static void OneByteReadBlockIntoBuffer(const unibrow::byte* chars,
+                                         ReadBlockBuffer* buffer,
+                                         unsigned* offset_ptr,
+                                         unsigned max_chars);
 
  private:
   // Slow case of String::Equals.  This implementation works on any strings
@@ -141,7 +141,7 @@ function DoRegExpExec(regexp, string, index) {
 
 
 function DoRegExpExecGlobal(regexp, string) {
-  // Returns an array of arrays of substring indices.
+  // Returns null or an array of the capture positions of all matches.
   return %RegExpExecGlobal(regexp, string, lastMatchInfo);
 }
 
@@ -41,7 +41,8 @@ RegExpMacroAssemblerIrregexp::RegExpMacroAssemblerIrregexp(Vector<byte> buffer)
     : buffer_(buffer),
       pc_(0),
       own_buffer_(false),
-      advance_current_end_(kInvalidPC) {
+      advance_current_end_(kInvalidPC),
+      load_char_end_(kInvalidPC) {
 }
 
 
@@ -59,6 +60,7 @@ RegExpMacroAssemblerIrregexp::Implementation() {
 
 void RegExpMacroAssemblerIrregexp::Bind(Label* l) {
   advance_current_end_ = kInvalidPC;
+  load_char_end_ = kInvalidPC;
   ASSERT(!l->is_bound());
   if (l->is_linked()) {
     int pos = l->pos();
@@ -179,6 +181,7 @@ void RegExpMacroAssemblerIrregexp::GoTo(Label* l) {
   if (advance_current_end_ == pc_) {
     // Combine advance current and goto.
     pc_ = advance_current_start_;
+    load_char_end_ = kInvalidPC;
     Emit(BC_ADVANCE_CP_AND_GOTO, advance_current_offset_);
     EmitOrLink(l);
     advance_current_end_ = kInvalidPC;
@@ -249,8 +252,43 @@ void RegExpMacroAssemblerIrregexp::LoadCurrentCharacter(int cp_offset,
       bytecode = BC_LOAD_CURRENT_CHAR_UNCHECKED;
     }
   }
+  load_char_start_ = pc_;
   Emit(bytecode, cp_offset);
   if (check_bounds) EmitOrLink(on_failure);
+  if (characters == 1) {
+    load_char_offset_ = cp_offset;
+    load_char_end_ = pc_;
+    load_char_checked_ = check_bounds;
+    load_char_on_failure_ = (on_failure == NULL) ? &backtrack_ : on_failure;
+  } else {
+    load_char_end_ = kInvalidPC;
+  }
+}
+
+
+bool RegExpMacroAssemblerIrregexp::FuseCheckWithLoad(uint32_t c,
+                                                     Label* on_match,
+                                                     bool on_equal) {
+  if (load_char_end_ != pc_) return false;
+  if (on_match == NULL) on_match = &backtrack_;
+  if (load_char_checked_) {
+    // Only a check that fails to the same place as the load fits in one
+    // bytecode, and then the load's already linked jump target is shared.
+    if (on_equal || on_match != load_char_on_failure_) return false;
+    *reinterpret_cast<uint32_t*>(buffer_.start() + load_char_start_) =
+        (static_cast<uint32_t>(load_char_offset_) << BYTECODE_SHIFT) |
+        BC_LOAD_CHAR_CHECK_NOT_CHAR;
+    Emit32(c);
+  } else {
+    pc_ = load_char_start_;
+    Emit(on_equal ? BC_LOAD_CHAR_UNCHECKED_CHECK_CHAR
+                  : BC_LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR,
+         load_char_offset_);
+    Emit32(c);
+    EmitOrLink(on_match);
+  }
+  load_char_end_ = kInvalidPC;
+  return true;
 }
 
 
@@ -269,6 +307,7 @@ void RegExpMacroAssemblerIrregexp::CheckCharacterGT(uc16 limit,
 
 
 void RegExpMacroAssemblerIrregexp::CheckCharacter(uint32_t c, Label* on_equal) {
+  if (FuseCheckWithLoad(c, on_equal, true)) return;
   if (c > MAX_FIRST_ARG) {
     Emit(BC_CHECK_4_CHARS, 0);
     Emit32(c);
@@ -293,6 +332,7 @@ void RegExpMacroAssemblerIrregexp::CheckNotAtStart(Label* on_not_at_start) {
 
 void RegExpMacroAssemblerIrregexp::CheckNotCharacter(uint32_t c,
                                                      Label* on_not_equal) {
+  if (FuseCheckWithLoad(c, on_not_equal, false)) return;
   if (c > MAX_FIRST_ARG) {
     Emit(BC_CHECK_NOT_4_CHARS, 0);
     Emit32(c);
@@ -417,13 +457,14 @@ void RegExpMacroAssemblerIrregexp::CheckCharacters(
   // load below.
   for (int i = str.length() - 1; i >= 0; i--) {
     if (check_end_of_string && i == str.length() - 1) {
-      Emit(BC_LOAD_CURRENT_CHAR, cp_offset + i);
+      Emit(BC_LOAD_CHAR_CHECK_NOT_CHAR, cp_offset + i);
       EmitOrLink(on_failure);
+      Emit32(str[i]);
     } else {
-      Emit(BC_LOAD_CURRENT_CHAR_UNCHECKED, cp_offset + i);
+      Emit(BC_LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR, cp_offset + i);
+      Emit32(str[i]);
+      EmitOrLink(on_failure);
     }
-    Emit(BC_CHECK_NOT_CHAR, str[i]);
-    EmitOrLink(on_failure);
   }
 }
 
@@ -122,6 +122,8 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
   inline void Emit32(uint32_t x);
   inline void Emit16(uint32_t x);
   inline void Emit(uint32_t bc, uint32_t arg);
+  // Fuses a character check with the character load just before it.
+  bool FuseCheckWithLoad(uint32_t c, Label* on_match, bool on_equal);
   // Bytecode buffer.
   int length();
   void Copy(Address a);
@@ -138,6 +140,14 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
   int advance_current_offset_;
   int advance_current_end_;
 
+  // The last single character load, which a following character check may
+  // be fused with.
+  int load_char_start_;
+  int load_char_offset_;
+  int load_char_end_;
+  bool load_char_checked_;
+  Label* load_char_on_failure_;
+
   static const int kInvalidPC = -1;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(RegExpMacroAssemblerIrregexp);
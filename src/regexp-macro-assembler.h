@@ -43,9 +43,20 @@ class RegExpMacroAssembler {
   static const int kMaxRegister = (1 << 16) - 1;
   static const int kMaxCPOffset = (1 << 15) - 1;
   static const int kMinCPOffset = -(1 << 15);
+  // Maps ASCII characters to their lower case equivalent.
+  static const byte kAsciiToLowerCase[128];
+  // Case-independent comparison of two characters of which at least one is
+  // ASCII.  ASCII characters are only case equivalent to other ASCII
+  // characters, so this needs no lookups in the unicode tables.
+  static inline bool AsciiCaseIndependentEquals(uc32 a, uc32 b) {
+    ASSERT(a < 128 || b < 128);
+    if ((a | b) >= 128) return false;
+    return kAsciiToLowerCase[a] == kAsciiToLowerCase[b];
+  }
   enum IrregexpImplementation {
     kIA32Implementation,
     kARMImplementation,
+    kX64Implementation,
     kBytecodeImplementation
   };
 
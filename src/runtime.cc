@@ -1042,6 +1042,21 @@ static Object* Runtime_RegExpExec(Arguments args) {
 }
 
 
+static Object* Runtime_RegExpExecGlobal(Arguments args) {
+  HandleScope scope;
+  ASSERT(args.length() == 3);
+  CONVERT_ARG_CHECKED(JSRegExp, regexp, 0);
+  CONVERT_ARG_CHECKED(String, subject, 1);
+  CONVERT_ARG_CHECKED(JSArray, last_match_info, 2);
+  RUNTIME_ASSERT(last_match_info->HasFastElements());
+  Handle<Object> result = RegExpImpl::ExecGlobal(regexp,
+                                                 subject,
+                                                 last_match_info);
+  if (result.is_null()) return Failure::Exception();
+  return *result;
+}
+
+
 static Object* Runtime_MaterializeRegExpLiteral(Arguments args) {
   HandleScope scope;
   ASSERT(args.length() == 4);
@@ -2052,6 +2067,31 @@ static int SingleCharIndexOf(Vector<const schar> string,
   return -1;
 }
 
+// Finds the first position from i up to and including n at which the
+// subject has the given character, or returns -1.  One-byte subjects are
+// scanned with memchr.
+template <typename schar, typename pchar>
+static inline int FindFirstCharacter(Vector<const schar> subject,
+                                     pchar pattern_first_char,
+                                     int i,
+                                     int n) {
+  if (sizeof(schar) == 1) {
+    if (static_cast<uc16>(pattern_first_char) > String::kMaxAsciiCharCode) {
+      return -1;
+    }
+    const void* pos = memchr(subject.start() + i,
+                             pattern_first_char,
+                             static_cast<size_t>(n - i + 1));
+    if (pos == NULL) return -1;
+    return reinterpret_cast<const schar*>(pos) - subject.start();
+  }
+  for (; i <= n; i++) {
+    if (subject[i] == pattern_first_char) return i;
+  }
+  return -1;
+}
+
+
 // Trivial string search for shorter strings.
 // On return, if "complete" is set to true, the return value is the
 // final result of searching for the patter in the subject.
@@ -2066,18 +2106,28 @@ static int SimpleIndexOf(Vector<const schar> subject,
   // Badness is a count of how much work we have done.  When we have
   // done enough work we decide it's probably worth switching to a better
   // algorithm.
-  int badness = -10 - (pattern.length() << 2);
+  const int initial_badness = -10 - (pattern.length() << 2);
+  int badness = initial_badness;
   // We know our pattern is at least 2 characters, we cache the first so
   // the common case of the first character not matching is faster.
   pchar pattern_first_char = pattern[0];
 
   for (int i = idx, n = subject.length() - pattern.length(); i <= n; i++) {
+    int scan_start = i;
+    i = FindFirstCharacter(subject, pattern_first_char, i, n);
+    if (i < 0) break;
+    if (sizeof(schar) == 1) {
+      // Characters skipped by memchr are cheaper than a Boyer-Moore shift
+      // and earn back budget, but never more than we started with.
+      badness = Max(initial_badness, badness - (i - scan_start));
+    } else {
+      badness += i - scan_start;
+    }
     badness++;
     if (badness > 0) {
       *complete = false;
       return i;
     }
-    if (subject[i] != pattern_first_char) continue;
     int j = 1;
     do {
       if (pattern[j] != subject[i+j]) {
@@ -2102,7 +2152,8 @@ static int SimpleIndexOf(Vector<const schar> subject,
                          int idx) {
   pchar pattern_first_char = pattern[0];
   for (int i = idx, n = subject.length() - pattern.length(); i <= n; i++) {
-    if (subject[i] != pattern_first_char) continue;
+    i = FindFirstCharacter(subject, pattern_first_char, i, n);
+    if (i < 0) return -1;
     int j = 1;
     do {
       if (pattern[j] != subject[i+j]) {
@@ -2125,9 +2176,9 @@ static int StringMatchStrategy(Vector<const schar> sub,
                                int start_index) {
   ASSERT(pat.length() > 1);
 
-  // We have an ASCII haystack and a non-ASCII needle. Check if there
-  // really is a non-ASCII character in the needle and bail out if there
-  // is.
+  // We have a one-byte haystack and a two-byte needle. Check if there
+  // really is a character outside Latin-1 in the needle and bail out if
+  // there is.
   if (sizeof(pchar) > 1 && sizeof(schar) == 1) {
     for (int i = 0; i < pat.length(); i++) {
       uc16 c = pat[i];
@@ -2179,15 +2230,15 @@ int Runtime::StringMatch(Handle<String> sub,
       if (pchar > String::kMaxAsciiCharCode) {
         return -1;
       }
-      Vector<const char> ascii_vector =
-        sub->ToAsciiVector().SubVector(start_index, subject_length);
+      Vector<const byte> ascii_vector =
+        sub->ToOneByteVector().SubVector(start_index, subject_length);
       const void* pos = memchr(ascii_vector.start(),
-                               static_cast<const char>(pchar),
+                               pchar,
                                static_cast<size_t>(ascii_vector.length()));
       if (pos == NULL) {
         return -1;
       }
-      return reinterpret_cast<const char*>(pos) - ascii_vector.start()
+      return reinterpret_cast<const byte*>(pos) - ascii_vector.start()
           + start_index;
     }
     return SingleCharIndexOf(sub->ToUC16Vector(), pat->Get(0), start_index);
@@ -2199,16 +2250,20 @@ int Runtime::StringMatch(Handle<String> sub,
 
   AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
   // dispatch on type of strings
+  // One-byte strings are matched as unsigned bytes so that Latin-1
+  // characters compare equal to their two-byte counterparts.
   if (pat->IsAsciiRepresentation()) {
-    Vector<const char> pat_vector = pat->ToAsciiVector();
+    Vector<const byte> pat_vector = pat->ToOneByteVector();
     if (sub->IsAsciiRepresentation()) {
-      return StringMatchStrategy(sub->ToAsciiVector(), pat_vector, start_index);
+      return StringMatchStrategy(sub->ToOneByteVector(),
+                                 pat_vector,
+                                 start_index);
     }
     return StringMatchStrategy(sub->ToUC16Vector(), pat_vector, start_index);
   }
   Vector<const uc16> pat_vector = pat->ToUC16Vector();
   if (sub->IsAsciiRepresentation()) {
-    return StringMatchStrategy(sub->ToAsciiVector(), pat_vector, start_index);
+    return StringMatchStrategy(sub->ToOneByteVector(), pat_vector, start_index);
   }
   return StringMatchStrategy(sub->ToUC16Vector(), pat_vector, start_index);
 }
@@ -3392,6 +3447,7 @@ template <class Converter>
 static Object* ConvertCaseHelper(String* s,
                                  int length,
                                  int input_string_length,
+                                 bool ascii_result,
                                  unibrow::Mapping<Converter, 128>* mapping) {
   // We try this twice, once with the assumption that the result is no longer
   // than the input and, if that assumption breaks, again with the exact
@@ -3400,11 +3456,11 @@ static Object* ConvertCaseHelper(String* s,
   //
   // Allocate the resulting string.
   //
-  // NOTE: This assumes that the upper/lower case of an ascii
-  // character is also ascii.  This is currently the case, but it
-  // might break in the future if we implement more context and locale
-  // dependent upper/lower conversions.
-  Object* o = s->IsAsciiRepresentation()
+  // NOTE: The upper case of a few Latin-1 characters (\u00b5 and \u00ff)
+  // is outside Latin-1.  If such a character turns up while filling an
+  // ascii result we give up and return undefined, and the caller tries
+  // again with a two-byte result.
+  Object* o = ascii_result
       ? Heap::AllocateRawAsciiString(length)
       : Heap::AllocateRawTwoByteString(length);
   if (o->IsFailure()) return o;
@@ -3429,6 +3485,9 @@ static Object* ConvertCaseHelper(String* s,
     } else if (char_length == 1) {
       // Common case: converting the letter resulted in one character.
       ASSERT(static_cast<uc32>(chars[0]) != current);
+      if (ascii_result && chars[0] > String::kMaxAsciiCharCodeU) {
+        return Heap::undefined_value();
+      }
       result->Set(i, chars[0]);
       has_changed_character = true;
       i++;
@@ -3468,6 +3527,9 @@ static Object* ConvertCaseHelper(String* s,
       return Smi::FromInt(current_length);
     } else {
       for (int j = 0; j < char_length; j++) {
+        if (ascii_result && chars[j] > String::kMaxAsciiCharCodeU) {
+          return Heap::undefined_value();
+        }
         result->Set(i, chars[j]);
         i++;
       }
@@ -3487,9 +3549,126 @@ static Object* ConvertCaseHelper(String* s,
 }
 
 
+// The ASCII fast path of the case conversions works on a word of
+// characters at a time.  All bytes involved are known to be 7-bit, so
+// adding a constant of at most 0x80 to a byte never carries into the next
+// byte, and the high bit of each byte is free to hold the result of a
+// comparison.
+static const uintptr_t kOneInEveryByte = static_cast<uintptr_t>(-1) / 0xFF;
+static const uintptr_t kAsciiMask = kOneInEveryByte * 0x80;
+
+
+// Returns a word with the high bit set in every byte of the 7-bit word w
+// that lies in the range [lo, hi].
+static inline uintptr_t AsciiRangeMask(uintptr_t w, char lo, char hi) {
+  uintptr_t at_least_lo = w + kOneInEveryByte * (0x80 - lo);
+  uintptr_t above_hi = w + kOneInEveryByte * (0x7F - hi);
+  return at_least_lo & ~above_hi & kAsciiMask;
+}
+
+
+static inline bool IsWordAligned(const char* p) {
+  return IsAligned(reinterpret_cast<uintptr_t>(p), sizeof(uintptr_t));
+}
+
+
+// Returns the index of the first character of an ascii string that lies
+// in [lo, hi], the length of the string if there is none, or -1 if the
+// string has a character outside 7-bit ASCII.
+static int FindAsciiCaseChange(Vector<const char> chars, char lo, char hi) {
+  const char* src = chars.start();
+  int length = chars.length();
+  int i = 0;
+  while (i < length) {
+    if (IsWordAligned(src + i) &&
+        i + static_cast<int>(sizeof(uintptr_t)) <= length) {
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(src + i);
+      if ((w & kAsciiMask) == 0 && AsciiRangeMask(w, lo, hi) == 0) {
+        i += sizeof(uintptr_t);
+        continue;
+      }
+    }
+    // Look at the characters of the word one by one.
+    unsigned char c = static_cast<unsigned char>(src[i]);
+    if (c > unibrow::Utf8::kMaxOneByteChar) return -1;
+    if (lo <= c && c <= hi) return i;
+    i++;
+  }
+  return length;
+}
+
+
+// Copies length 7-bit ASCII characters from src to dst, flipping the case
+// of the letters in [lo, hi].  Returns false if it runs into a character
+// outside 7-bit ASCII, leaving the rest of dst unwritten.
+static bool FlipAsciiCase(char* dst,
+                          const char* src,
+                          int length,
+                          char lo,
+                          char hi) {
+  // Upper and lower case ASCII letters differ only in this bit, which is
+  // the high bit of a byte shifted right by two.
+  const char kCaseBit = 0x20;
+  ASSERT((kAsciiMask >> 2) == kOneInEveryByte * kCaseBit);
+  // Whole words can be used if src and dst are aligned at the same time.
+  bool use_words = ((reinterpret_cast<uintptr_t>(src) -
+                     reinterpret_cast<uintptr_t>(dst)) &
+                    (sizeof(uintptr_t) - 1)) == 0;
+  int i = 0;
+  while (i < length) {
+    if (use_words && IsWordAligned(src + i) &&
+        i + static_cast<int>(sizeof(uintptr_t)) <= length) {
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(src + i);
+      if ((w & kAsciiMask) != 0) return false;
+      *reinterpret_cast<uintptr_t*>(dst + i) =
+          w ^ (AsciiRangeMask(w, lo, hi) >> 2);
+      i += sizeof(uintptr_t);
+      continue;
+    }
+    char c = src[i];
+    if (static_cast<unsigned char>(c) > unibrow::Utf8::kMaxOneByteChar) {
+      return false;
+    }
+    if (lo <= c && c <= hi) c ^= kCaseBit;
+    dst[i] = c;
+    i++;
+  }
+  return true;
+}
+
+
+// Converts the case of a flat string whose characters are all 7-bit ASCII
+// by flipping the case bit of the letters in [lo, hi].  Returns the string
+// itself if nothing changes, and undefined if the string has characters
+// outside 7-bit ASCII, in which case the full Unicode mapping must be used.
+static Object* ConvertAsciiCase(String* s, char lo, char hi) {
+  Vector<const char> chars = s->ToAsciiVector();
+  int first_change = FindAsciiCaseChange(chars, lo, hi);
+  if (first_change < 0) return Heap::undefined_value();
+  if (first_change == chars.length()) return s;
+
+  int length = chars.length();
+  Object* o = Heap::AllocateRawAsciiString(length);
+  if (o->IsFailure()) return o;
+  SeqAsciiString* result = SeqAsciiString::cast(o);
+  char* dst = result->GetChars();
+  memcpy(dst, chars.start(), first_change);
+  if (!FlipAsciiCase(dst + first_change,
+                     chars.start() + first_change,
+                     length - first_change,
+                     lo,
+                     hi)) {
+    return Heap::undefined_value();
+  }
+  return result;
+}
+
+
 template <class Converter>
 static Object* ConvertCase(Arguments args,
-                           unibrow::Mapping<Converter, 128>* mapping) {
+                           unibrow::Mapping<Converter, 128>* mapping,
+                           char ascii_lo,
+                           char ascii_hi) {
   NoHandleAllocation ha;
 
   CONVERT_CHECKED(String, s, args[0]);
@@ -3499,23 +3678,49 @@ static Object* ConvertCase(Arguments args,
   // Assume that the string is not empty; we need this assumption later
   if (input_string_length == 0) return s;
   int length = input_string_length;
+  bool ascii_result = s->IsAsciiRepresentation();
 
-  Object* answer = ConvertCaseHelper(s, length, length, mapping);
-  if (answer->IsSmi()) {
-    // Retry with correct length.
-    answer = ConvertCaseHelper(s, Smi::cast(answer)->value(), length, mapping);
+  // In 7-bit ASCII the case mappings only change the letters in
+  // [ascii_lo, ascii_hi], which differ from their counterparts in one bit.
+  if (ascii_result && s->IsFlat()) {
+    Object* answer = ConvertAsciiCase(s, ascii_lo, ascii_hi);
+    if (!answer->IsUndefined()) return answer;
+  }
+
+  Object* answer =
+      ConvertCaseHelper(s, length, length, ascii_result, mapping);
+  while (true) {
+    if (answer->IsSmi()) {
+      // Retry with correct length.
+      length = Smi::cast(answer)->value();
+    } else if (answer->IsUndefined()) {
+      // Retry with a two-byte result.
+      ascii_result = false;
+    } else {
+      return answer;  // This may be a failure.
+    }
+    answer = ConvertCaseHelper(s,
+                               length,
+                               input_string_length,
+                               ascii_result,
+                               mapping);
   }
-  return answer;  // This may be a failure.
 }
 
 
 static Object* Runtime_StringToLowerCase(Arguments args) {
-  return ConvertCase<unibrow::ToLowercase>(args, &to_lower_mapping);
+  return ConvertCase<unibrow::ToLowercase>(args,
+                                           &to_lower_mapping,
+                                           'A',
+                                           'Z');
 }
 
 
 static Object* Runtime_StringToUpperCase(Arguments args) {
-  return ConvertCase<unibrow::ToUppercase>(args, &to_upper_mapping);
+  return ConvertCase<unibrow::ToUppercase>(args,
+                                           &to_upper_mapping,
+                                           'a',
+                                           'z');
 }
 
 
@@ -4388,6 +4593,22 @@ static Object* Runtime_LazyCompile(Arguments args) {
 }
 
 
+static Object* Runtime_OptimizeFunction(Arguments args) {
+  HandleScope scope;
+  ASSERT(args.length() == 1);
+
+  Handle<JSFunction> function = args.at<JSFunction>(0);
+  Handle<SharedFunctionInfo> shared(function->shared());
+
+  // Functions are recompiled at most once.  Code for the function that
+  // is still running counts down from the maximum and does not get
+  // here again in practice.
+  shared->set_hotness_count(Smi::kMaxValue);
+  Compiler::CompileOptimized(shared);
+  return Heap::undefined_value();
+}
+
+
 static Object* Runtime_GetCalledFunction(Arguments args) {
   HandleScope scope;
   ASSERT(args.length() == 0);
@@ -4900,7 +5121,7 @@ static Object* Runtime_DateParseString(Arguments args) {
   RUNTIME_ASSERT(output_array->length() >= DateParser::OUTPUT_SIZE);
   bool result;
   if (str->IsAsciiRepresentation()) {
-    result = DateParser::Parse(str->ToAsciiVector(), output_array);
+    result = DateParser::Parse(str->ToOneByteVector(), output_array);
   } else {
     ASSERT(str->IsTwoByteRepresentation());
     result = DateParser::Parse(str->ToUC16Vector(), output_array);
@@ -68,6 +68,7 @@ namespace internal {
   F(NewArguments, 1) \
   F(NewArgumentsFast, 3) \
   F(LazyCompile, 1) \
+  F(OptimizeFunction, 1) \
   F(SetNewFunctionAttributes, 1) \
   \
   /* Array join support */ \
@@ -143,6 +144,7 @@ namespace internal {
   /* Regular expressions */ \
   F(RegExpCompile, 3) \
   F(RegExpExec, 4) \
+  F(RegExpExecGlobal, 3) \
   \
   /* Strings */ \
   F(StringCharCodeAt, 2) \
@@ -652,6 +652,14 @@ void ExternalReferenceTable::PopulateTable() {
       STUB_CACHE_TABLE,
       4,
       "StubCache::secondary_->value");
+  Add(SCTableReference::maskReference(StubCache::kPrimary).address(),
+      STUB_CACHE_TABLE,
+      5,
+      "StubCache::primary_mask_");
+  Add(SCTableReference::maskReference(StubCache::kSecondary).address(),
+      STUB_CACHE_TABLE,
+      6,
+      "StubCache::secondary_mask_");
 
   // Runtime entries
   Add(ExternalReference::perform_gc_function().address(),
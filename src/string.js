@@ -363,60 +363,59 @@ function addCaptureString(builder, matchInfo, index) {
 
 
 // Helper function for replacing regular expressions with the result of a
-// function application in String.prototype.replace.  The function application
-// must be interleaved with the regexp matching (contrary to ECMA-262
-// 15.5.4.11) to mimic SpiderMonkey and KJS behavior when the function uses
-// the static properties of the RegExp constructor.  Example:
+// function application in String.prototype.replace.  For a global regexp all
+// the matches are found in one go, but to mimic SpiderMonkey and KJS behavior
+// when the function uses the static properties of the RegExp constructor (and
+// contrary to ECMA-262 15.5.4.11) lastMatchInfo is made to describe each match
+// as the function is applied to it.  Example:
 //     'abcd'.replace(/(.)/g, function() { return RegExp.$1; }
 // should be 'abcd' and not 'dddd' (or anything else).
 function StringReplaceRegExpWithFunction(subject, regexp, replace) {
+  if (regexp.global) {
+    return StringReplaceGlobalRegExpWithFunction(subject, regexp, replace);
+  }
+
   var lastMatchInfo = DoRegExpExec(regexp, subject, 0);
   if (IS_NULL(lastMatchInfo)) return subject;
 
   var result = new ReplaceResultBuilder(subject);
-  // There's at least one match.  If the regexp is global, we have to loop
-  // over all matches.  The loop is not in C++ code here like the one in
-  // RegExp.prototype.exec, because of the interleaved function application.
-  // Unfortunately, that means this code is nearly duplicated, here and in
-  // jsregexp.cc.
-  if (regexp.global) {
-    var previous = 0;
-    do {
-      result.addSpecialSlice(previous, lastMatchInfo[CAPTURE0]);
-      var startOfMatch = lastMatchInfo[CAPTURE0];
-      previous = lastMatchInfo[CAPTURE1];
-      result.add(ApplyReplacementFunction(replace, lastMatchInfo, subject));
-      // Can't use lastMatchInfo any more from here, since the function could
-      // overwrite it.
-      // Continue with the next match.
-      // Increment previous if we matched an empty string, as per ECMA-262
-      // 15.5.4.10.
-      if (previous == startOfMatch) {
-        // Add the skipped character to the output, if any.
-        if (previous < subject.length) {
-          result.addSpecialSlice(previous, previous + 1);
-        }
-        previous++;
-      }
+  result.addSpecialSlice(0, lastMatchInfo[CAPTURE0]);
+  var endOfMatch = lastMatchInfo[CAPTURE1];
+  result.add(ApplyReplacementFunction(replace, lastMatchInfo, subject));
+  // Can't use lastMatchInfo any more from here, since the function could
+  // overwrite it.
+  result.addSpecialSlice(endOfMatch, subject.length);
 
-      // Per ECMA-262 15.10.6.2, if the previous index is greater than the
-      // string length, there is no match
-      lastMatchInfo = (previous > subject.length)
-          ? null
-          : DoRegExpExec(regexp, subject, previous);
-    } while (!IS_NULL(lastMatchInfo));
+  return result.generate();
+}
+
+
+function StringReplaceGlobalRegExpWithFunction(subject, regexp, replace) {
+  // An array of the capture positions of all matches, one after the other.
+  var matches = DoRegExpExecGlobal(regexp, subject);
+  if (IS_NULL(matches)) return subject;
 
-    // Tack on the final right substring after the last match, if necessary.
-    if (previous < subject.length) {
-      result.addSpecialSlice(previous, subject.length);
+  var result = new ReplaceResultBuilder(subject);
+  var numberOfCaptures = NUMBER_OF_CAPTURES(lastMatchInfo);
+  var previous = 0;
+  for (var i = 0; i < matches.length; i += numberOfCaptures) {
+    // The function could have run other regexps and overwritten all of
+    // lastMatchInfo.
+    NUMBER_OF_CAPTURES(lastMatchInfo) = numberOfCaptures;
+    LAST_SUBJECT(lastMatchInfo) = subject;
+    LAST_INPUT(lastMatchInfo) = subject;
+    for (var j = 0; j < numberOfCaptures; j++) {
+      lastMatchInfo[CAPTURE(j)] = matches[i + j];
     }
-  } else { // Not a global regexp, no need to loop.
-    result.addSpecialSlice(0, lastMatchInfo[CAPTURE0]);
-    var endOfMatch = lastMatchInfo[CAPTURE1];
+    // Any characters skipped after an empty match are part of the slice.
+    result.addSpecialSlice(previous, lastMatchInfo[CAPTURE0]);
+    previous = lastMatchInfo[CAPTURE1];
     result.add(ApplyReplacementFunction(replace, lastMatchInfo, subject));
-    // Can't use lastMatchInfo any more from here, since the function could
-    // overwrite it.
-    result.addSpecialSlice(endOfMatch, subject.length);
+  }
+
+  // Tack on the final right substring after the last match, if necessary.
+  if (previous < subject.length) {
+    result.addSpecialSlice(previous, subject.length);
   }
 
   return result.generate();
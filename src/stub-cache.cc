@@ -39,12 +39,28 @@ namespace internal {
 // StubCache implementation.
 
 
-StubCache::Entry StubCache::primary_[StubCache::kPrimaryTableSize];
-StubCache::Entry StubCache::secondary_[StubCache::kSecondaryTableSize];
+StubCache::Entry StubCache::primary_[StubCache::kMaxPrimaryTableSize];
+StubCache::Entry StubCache::secondary_[StubCache::kMaxSecondaryTableSize];
+int StubCache::primary_table_size_ = 0;
+int StubCache::primary_mask_ = 0;
+int StubCache::secondary_mask_ = 0;
+int StubCache::evictions_since_clear_ = 0;
+
+
+void StubCache::SetPrimaryTableSize(int size) {
+  ASSERT(IsPowerOf2(size));
+  ASSERT(kMinPrimaryTableSize <= size && size <= kMaxPrimaryTableSize);
+  primary_table_size_ = size;
+  primary_mask_ = (size - 1) << kHeapObjectTagSize;
+  secondary_mask_ = (size / kSecondaryTableRatio - 1) << kHeapObjectTagSize;
+}
+
 
 void StubCache::Initialize(bool create_heap_objects) {
-  ASSERT(IsPowerOf2(kPrimaryTableSize));
-  ASSERT(IsPowerOf2(kSecondaryTableSize));
+  int size = Max(FLAG_stub_cache_size, kMinPrimaryTableSize);
+  size = Min(static_cast<int>(RoundUpToPowerOf2(size)), kMaxPrimaryTableSize);
+  SetPrimaryTableSize(size);
+  evictions_since_clear_ = 0;
   if (create_heap_objects) {
     HandleScope scope;
     Clear();
@@ -83,8 +99,13 @@ Code* StubCache::Set(String* name, Map* map, Code* code) {
     int secondary_offset =
         SecondaryOffset(primary->key, primary_flags, primary_offset);
     Entry* secondary = entry(secondary_, secondary_offset);
+    if (secondary->value != Builtins::builtin(Builtins::Illegal)) {
+      Counters::megamorphic_stub_cache_evictions.Increment();
+      evictions_since_clear_++;
+    }
     *secondary = *primary;
   }
+  Counters::megamorphic_stub_cache_updates.Increment();
 
   // Update primary cache.
   primary->key = name;
@@ -195,6 +216,18 @@ Object* StubCache::ComputeLoadGlobal(String* name,
 }
 
 
+Object* StubCache::ComputeLoadPolymorphic(String* name,
+                                          int count,
+                                          Map** maps,
+                                          Code** handlers) {
+  LoadStubCompiler compiler;
+  Object* code = compiler.CompileLoadPolymorphic(count, maps, handlers, name);
+  if (code->IsFailure()) return code;
+  LOG(CodeCreateEvent(Logger::LOAD_IC_TAG, Code::cast(code), name));
+  return code;
+}
+
+
 Object* StubCache::ComputeKeyedLoadField(String* name,
                                          JSObject* receiver,
                                          JSObject* holder,
@@ -567,6 +600,20 @@ Object* StubCache::ComputeCallGlobal(int argc,
 }
 
 
+Object* StubCache::ComputeCallPolymorphic(int argc,
+                                          InLoopFlag in_loop,
+                                          String* name,
+                                          int count,
+                                          Map** maps,
+                                          Code** handlers) {
+  CallStubCompiler compiler(argc, in_loop);
+  Object* code = compiler.CompileCallPolymorphic(count, maps, handlers, name);
+  if (code->IsFailure()) return code;
+  LOG(CodeCreateEvent(Logger::CALL_IC_TAG, Code::cast(code), name));
+  return code;
+}
+
+
 static Object* GetProbeValue(Code::Flags flags) {
   // Use raw_unchecked... so we don't get assert failures during GC.
   NumberDictionary* dictionary = Heap::raw_unchecked_non_monomorphic_cache();
@@ -712,11 +759,24 @@ Object* StubCache::ComputeLazyCompile(int argc) {
 
 
 void StubCache::Clear() {
-  for (int i = 0; i < kPrimaryTableSize; i++) {
+  // Entries dropped from the secondary table have to be recomputed by
+  // the runtime the next time they are needed.  If that happened more
+  // often than the secondary table has entries, the hot stubs do not
+  // fit and the tables are grown.
+  int secondary_table_size = primary_table_size_ / kSecondaryTableRatio;
+  if (FLAG_grow_stub_cache &&
+      evictions_since_clear_ > secondary_table_size &&
+      primary_table_size_ < kMaxPrimaryTableSize) {
+    SetPrimaryTableSize(primary_table_size_ * 2);
+    secondary_table_size = primary_table_size_ / kSecondaryTableRatio;
+  }
+  evictions_since_clear_ = 0;
+
+  for (int i = 0; i < primary_table_size_; i++) {
     primary_[i].key = Heap::empty_string();
     primary_[i].value = Builtins::builtin(Builtins::Illegal);
   }
-  for (int j = 0; j < kSecondaryTableSize; j++) {
+  for (int j = 0; j < secondary_table_size; j++) {
     secondary_[j].key = Heap::empty_string();
     secondary_[j].value = Builtins::builtin(Builtins::Illegal);
   }
@@ -1038,6 +1098,13 @@ Object* LoadStubCompiler::GetCode(PropertyType type, String* name) {
 }
 
 
+Object* LoadStubCompiler::GetPolymorphicCode(String* name) {
+  Code::Flags flags = Code::ComputeFlags(Code::LOAD_IC, NOT_IN_LOOP,
+                                         POLYMORPHIC, NORMAL);
+  return GetCodeWithFlags(flags, name);
+}
+
+
 Object* KeyedLoadStubCompiler::GetCode(PropertyType type, String* name) {
   Code::Flags flags = Code::ComputeMonomorphicFlags(Code::KEYED_LOAD_IC, type);
   return GetCodeWithFlags(flags, name);
@@ -1066,4 +1133,12 @@ Object* CallStubCompiler::GetCode(PropertyType type, String* name) {
 }
 
 
+Object* CallStubCompiler::GetPolymorphicCode(String* name) {
+  int argc = arguments_.immediate();
+  Code::Flags flags = Code::ComputeFlags(Code::CALL_IC, in_loop_,
+                                         POLYMORPHIC, NORMAL, argc);
+  return GetCodeWithFlags(flags, name);
+}
+
+
 } }  // namespace v8::internal
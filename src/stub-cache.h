@@ -84,6 +84,14 @@ class StubCache : public AllStatic {
                                    JSGlobalPropertyCell* cell,
                                    bool is_dont_delete);
 
+  // Polymorphic stubs dispatch on the receiver map to one of the given
+  // monomorphic handlers.  They are specific to a call site and are
+  // not entered in the stub cache.
+  static Object* ComputeLoadPolymorphic(String* name,
+                                        int count,
+                                        Map** maps,
+                                        Code** handlers);
+
 
   // ---
 
@@ -170,6 +178,13 @@ class StubCache : public AllStatic {
                                    JSGlobalPropertyCell* cell,
                                    JSFunction* function);
 
+  static Object* ComputeCallPolymorphic(int argc,
+                                        InLoopFlag in_loop,
+                                        String* name,
+                                        int count,
+                                        Map** maps,
+                                        Code** handlers);
+
   // ---
 
   static Object* ComputeCallInitialize(int argc, InLoopFlag in_loop);
@@ -192,9 +207,14 @@ class StubCache : public AllStatic {
   // Update cache for entry hash(name, map).
   static Code* Set(String* name, Map* map, Code* code);
 
-  // Clear the lookup table (@ mark compact collection).
+  // Clear the lookup table (@ mark compact collection).  If the
+  // secondary table overflowed many times since the last clear, the
+  // tables are grown first.
   static void Clear();
 
+  // Returns the number of entries in the primary table.
+  static int primary_table_size() { return primary_table_size_; }
+
   // Functions for generating stubs at startup.
   static void GenerateMiss(MacroAssembler* masm);
 
@@ -214,10 +234,25 @@ class StubCache : public AllStatic {
 
  private:
   friend class SCTableReference;
-  static const int kPrimaryTableSize = 2048;
-  static const int kSecondaryTableSize = 512;
+  // The tables are allocated at their maximum size, but only the part
+  // selected by the masks is in use.  Generated code reads the masks
+  // from memory so the tables can grow without regenerating it.
+  static const int kMinPrimaryTableSize = 256;
+  static const int kMaxPrimaryTableSize = 16384;
+  static const int kSecondaryTableRatio = 4;
+  static const int kMaxSecondaryTableSize =
+      kMaxPrimaryTableSize / kSecondaryTableRatio;
   static Entry primary_[];
   static Entry secondary_[];
+  static int primary_table_size_;
+  // The masks apply to hashed offsets, which are scaled by the heap
+  // object tag size.
+  static int primary_mask_;
+  static int secondary_mask_;
+  // Number of live secondary entries overwritten since the last clear.
+  static int evictions_since_clear_;
+
+  static void SetPrimaryTableSize(int size);
 
   // Computes the hashed offsets for primary and secondary caches.
   static int PrimaryOffset(String* name, Code::Flags flags, Map* map) {
@@ -240,7 +275,7 @@ class StubCache : public AllStatic {
         (static_cast<uint32_t>(flags) & ~Code::kFlagsNotUsedInLookup);
     // Base the offset on a simple combination of name, flags, and map.
     uint32_t key = (map_low32bits + field) ^ iflags;
-    return key & ((kPrimaryTableSize - 1) << kHeapObjectTagSize);
+    return key & primary_mask_;
   }
 
   static int SecondaryOffset(String* name, Code::Flags flags, int seed) {
@@ -252,15 +287,17 @@ class StubCache : public AllStatic {
     uint32_t iflags =
         (static_cast<uint32_t>(flags) & ~Code::kFlagsICInLoopMask);
     uint32_t key = seed - string_low32bits + iflags;
-    return key & ((kSecondaryTableSize - 1) << kHeapObjectTagSize);
+    return key & secondary_mask_;
   }
 
   // Compute the entry for a given offset in exactly the same way as
   // we done in generated code. This makes it a lot easier to avoid
-  // making mistakes in the hashed offset computations.
+  // making mistakes in the hashed offset computations.  The offsets
+  // are scaled by the hash shift; an entry is two pointers.
   static Entry* entry(Entry* table, int offset) {
+    const int shift_amount = kPointerSizeLog2 + 1 - String::kHashShift;
     return reinterpret_cast<Entry*>(
-        reinterpret_cast<Address>(table) + (offset << 1));
+        reinterpret_cast<Address>(table) + (offset << shift_amount));
   }
 };
 
@@ -278,6 +315,20 @@ class SCTableReference {
         reinterpret_cast<Address>(&first_entry(table)->value));
   }
 
+
+  static SCTableReference maskReference(StubCache::Table table) {
+    switch (table) {
+      case StubCache::kPrimary:
+        return SCTableReference(
+            reinterpret_cast<Address>(&StubCache::primary_mask_));
+      case StubCache::kSecondary:
+        return SCTableReference(
+            reinterpret_cast<Address>(&StubCache::secondary_mask_));
+    }
+    UNREACHABLE();
+    return SCTableReference(NULL);
+  }
+
   Address address() const { return address_; }
 
  private:
@@ -373,6 +424,13 @@ class StubCompiler BASE_EMBEDDED {
                                  Register scratch,
                                  Label* miss_label);
   static void GenerateLoadMiss(MacroAssembler* masm, Code::Kind kind);
+  static void GenerateMapDispatch(MacroAssembler* masm,
+                                  Register receiver,
+                                  Register scratch,
+                                  int count,
+                                  Map** maps,
+                                  Code** handlers,
+                                  Label* miss_label);
 
  protected:
   Object* GetCodeWithFlags(Code::Flags flags, const char* name);
@@ -460,8 +518,14 @@ class LoadStubCompiler: public StubCompiler {
                             String* name,
                             bool is_dont_delete);
 
+  Object* CompileLoadPolymorphic(int count,
+                                 Map** maps,
+                                 Code** handlers,
+                                 String* name);
+
  private:
   Object* GetCode(PropertyType type, String* name);
+  Object* GetPolymorphicCode(String* name);
 };
 
 
@@ -545,6 +609,10 @@ class CallStubCompiler: public StubCompiler {
                             JSGlobalPropertyCell* cell,
                             JSFunction* function,
                             String* name);
+  Object* CompileCallPolymorphic(int count,
+                                 Map** maps,
+                                 Code** handlers,
+                                 String* name);
 
  private:
   const ParameterCount arguments_;
@@ -553,6 +621,7 @@ class CallStubCompiler: public StubCompiler {
   const ParameterCount& arguments() { return arguments_; }
 
   Object* GetCode(PropertyType type, String* name);
+  Object* GetPolymorphicCode(String* name);
 };
 
 
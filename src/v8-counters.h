@@ -46,6 +46,7 @@ namespace internal {
   HT(compile, V8.Compile)                                             \
   HT(compile_eval, V8.CompileEval)                                    \
   HT(compile_lazy, V8.CompileLazy)                                    \
+  HT(compile_optimized, V8.CompileOptimized)                          \
   /* Individual compiler passes. */                                   \
   HT(rewriting, V8.Rewriting)                                         \
   HT(usage_analysis, V8.UsageAnalysis)                                \
@@ -86,6 +87,8 @@ namespace internal {
   SC(compilation_cache_misses, V8.CompilationCacheMisses)        \
   SC(regexp_cache_hits, V8.RegExpCacheHits)                      \
   SC(regexp_cache_misses, V8.RegExpCacheMisses)                  \
+  SC(regexp_result_cache_hits, V8.RegExpResultCacheHits)         \
+  SC(regexp_result_cache_misses, V8.RegExpResultCacheMisses)     \
   /* Amount of evaled source code. */                            \
   SC(total_eval_size, V8.TotalEvalSize)                          \
   /* Amount of loaded source code. */                            \
@@ -139,13 +142,33 @@ namespace internal {
   SC(named_store_global_inline_miss, V8.NamedStoreGlobalInlineMiss) \
   SC(call_global_inline, V8.CallGlobalInline)                       \
   SC(call_global_inline_miss, V8.CallGlobalInlineMiss)              \
+  /* Megamorphic stub cache probes by outcome, and updates. */      \
+  SC(megamorphic_stub_cache_primary_hits,                           \
+     V8.MegamorphicStubCachePrimaryHits)                            \
+  SC(megamorphic_stub_cache_secondary_hits,                         \
+     V8.MegamorphicStubCacheSecondaryHits)                          \
+  SC(megamorphic_stub_cache_misses, V8.MegamorphicStubCacheMisses)  \
+  SC(megamorphic_stub_cache_updates,                                \
+     V8.MegamorphicStubCacheUpdates)                                \
+  SC(megamorphic_stub_cache_evictions,                              \
+     V8.MegamorphicStubCacheEvictions)                              \
   SC(for_in, V8.ForIn)                                              \
   SC(enum_cache_hits, V8.EnumCacheHits)                             \
   SC(enum_cache_misses, V8.EnumCacheMisses)                         \
   SC(reloc_info_count, V8.RelocInfoCount)                           \
   SC(reloc_info_size, V8.RelocInfoSize)                             \
   SC(zone_segment_bytes, V8.ZoneSegmentBytes)                       \
-  SC(compute_entry_frame, V8.ComputeEntryFrame)
+  SC(compute_entry_frame, V8.ComputeEntryFrame)                     \
+  /* Number to string conversions done by Grisu3 and by dtoa. */    \
+  SC(fast_dtoa_hits, V8.FastDtoaHits)                               \
+  SC(fast_dtoa_misses, V8.FastDtoaMisses)                           \
+  /* String to number conversions by strategy used. */              \
+  SC(strtod_fast_path, V8.StrtodFastPath)                           \
+  SC(strtod_diy_fp, V8.StrtodDiyFp)                                 \
+  SC(strtod_bignum, V8.StrtodBignum)                                \
+  /* Sliced strings created, and trimmed by the GC. */              \
+  SC(sliced_strings_created, V8.SlicedStringsCreated)               \
+  SC(sliced_strings_trimmed, V8.SlicedStringsTrimmed)
 
 
 // This file contains all the v8 counters that are in use.
@@ -482,6 +482,9 @@ class Assembler : public Malloced {
   void movl(Register dst, const Operand& src);
   void movl(const Operand& dst, Register src);
   void movl(const Operand& dst, Immediate imm);
+  // Store the 32-bit displacement from the end of this instruction to the
+  // label. Used by code that turns it into a code-relative offset later.
+  void movl(const Operand& dst, Label* src);
   // Load a 32-bit immediate value, zero-extended to 64 bits.
   void movl(Register dst, Immediate imm32);
 
@@ -506,6 +509,7 @@ class Assembler : public Malloced {
   void movsxlq(Register dst, Register src);
   void movsxlq(Register dst, const Operand& src);
   void movzxbq(Register dst, const Operand& src);
+  void movzxwq(Register dst, const Operand& src);
 
   // New x64 instruction to load from an immediate 64-bit pointer into RAX.
   void load_rax(void* ptr, RelocInfo::Mode rmode);
@@ -562,6 +566,10 @@ class Assembler : public Malloced {
     immediate_arithmetic_op_8(0x7, dst, src);
   }
 
+  void cmpw(const Operand& dst, Immediate src) {
+    immediate_arithmetic_op_16(0x7, dst, src);
+  }
+
   void cmpl(Register dst, Register src) {
     arithmetic_op_32(0x3B, dst, src);
   }
@@ -958,6 +966,13 @@ class Assembler : public Malloced {
   // void dd(uint64_t data, RelocInfo::Mode reloc_info);
 
   int pc_offset() const  { return pc_ - buffer_; }
+  // Read/patch 32-bit values in the code generated so far.
+  uint32_t long_at(int pos)  {
+    return *reinterpret_cast<uint32_t*>(addr_at(pos));
+  }
+  void long_at_put(int pos, uint32_t x)  {
+    *reinterpret_cast<uint32_t*>(addr_at(pos)) = x;
+  }
   int current_statement_position() const { return current_statement_position_; }
   int current_position() const  { return current_position_; }
 
@@ -984,12 +999,6 @@ class Assembler : public Malloced {
  private:
   byte* addr_at(int pos)  { return buffer_ + pos; }
   byte byte_at(int pos)  { return buffer_[pos]; }
-  uint32_t long_at(int pos)  {
-    return *reinterpret_cast<uint32_t*>(addr_at(pos));
-  }
-  void long_at_put(int pos, uint32_t x)  {
-    *reinterpret_cast<uint32_t*>(addr_at(pos)) = x;
-  }
 
   // code emission
   void GrowBuffer();
@@ -1125,6 +1134,10 @@ class Assembler : public Malloced {
   void immediate_arithmetic_op_32(byte subcode,
                                   Register dst,
                                   Immediate src);
+  // Operate on a 16-bit word in memory.
+  void immediate_arithmetic_op_16(byte subcode,
+                                  const Operand& dst,
+                                  Immediate src);
   // Operate on a byte in memory or register.
   void immediate_arithmetic_op_8(byte subcode,
                                  const Operand& dst,
@@ -102,8 +102,10 @@ CodeGenState::~CodeGenState() {
 
 CodeGenerator::CodeGenerator(int buffer_size,
                              Handle<Script> script,
-                             bool is_eval)
+                             bool is_eval,
+                             bool is_optimizing)
     : is_eval_(is_eval),
+      is_optimizing_(is_optimizing),
       script_(script),
       deferred_(8),
       masm_(new MacroAssembler(NULL, buffer_size)),
@@ -268,6 +270,7 @@ void CodeGenerator::GenCode(FunctionLiteral* function) {
       // Ignore the return value.
     }
     CheckStack();
+    UpdateHotnessCount();
 
     // Compile the body of the function in a vanilla state. Don't
     // bother compiling all the code if the scope has an illegal
@@ -418,6 +421,47 @@ void CodeGenerator::CheckStack() {
 }
 
 
+class DeferredHotnessCount: public DeferredCode {
+ public:
+  DeferredHotnessCount() {
+    set_comment("[ DeferredHotnessCount");
+  }
+
+  virtual void Generate();
+};
+
+
+void DeferredHotnessCount::Generate() {
+  __ push(Operand(rbp, JavaScriptFrameConstants::kFunctionOffset));
+  __ CallRuntime(Runtime::kOptimizeFunction, 1);
+}
+
+
+void CodeGenerator::UpdateHotnessCount() {
+  // Only functions in user scripts that can be compiled lazily can be
+  // parsed again by the optimizing compiler.
+  if (!FLAG_optimize_hot_functions ||
+      is_optimizing() ||
+      !scope_->is_function_scope() ||
+      !scope_->AllowsLazyCompilation() ||
+      Smi::cast(script_->type())->value() != Script::TYPE_NORMAL) {
+    return;
+  }
+  DeferredHotnessCount* deferred = new DeferredHotnessCount;
+  Result shared = allocator_->Allocate();
+  ASSERT(shared.is_valid());
+  __ movq(shared.reg(),
+          Operand(rbp, JavaScriptFrameConstants::kFunctionOffset));
+  __ movq(shared.reg(),
+          FieldOperand(shared.reg(), JSFunction::kSharedFunctionInfoOffset));
+  __ subq(FieldOperand(shared.reg(), SharedFunctionInfo::kHotnessCountOffset),
+          Immediate(Smi::FromInt(1)));
+  shared.Unuse();
+  deferred->Branch(negative);
+  deferred->BindExit();
+}
+
+
 class CallFunctionStub: public CodeStub {
  public:
   CallFunctionStub(int argc, InLoopFlag in_loop)
@@ -910,6 +954,7 @@ void CodeGenerator::VisitLoopStatement(LoopStatement* node) {
       }
 
       CheckStack();  // TODO(1222600): ignore if body contains calls.
+      UpdateHotnessCount();
       Visit(node->body());
 
       // Compile the test.
@@ -1006,6 +1051,7 @@ void CodeGenerator::VisitLoopStatement(LoopStatement* node) {
       }
 
       CheckStack();  // TODO(1222600): ignore if body contains calls.
+      UpdateHotnessCount();
       Visit(node->body());
 
       // Based on the condition analysis, compile the backward jump as
@@ -1126,6 +1172,7 @@ void CodeGenerator::VisitLoopStatement(LoopStatement* node) {
       }
 
       CheckStack();  // TODO(1222600): ignore if body contains calls.
+      UpdateHotnessCount();
       Visit(node->body());
 
       // If there is an update expression, compile it if necessary.
@@ -1364,6 +1411,7 @@ void CodeGenerator::VisitForInStatement(ForInStatement* node) {
 
   // Body.
   CheckStack();  // TODO(1222600): ignore if body contains calls.
+  UpdateHotnessCount();
   VisitAndSpill(node->body());
 
   // Next.  Reestablish a spilled frame in case we are coming here via
@@ -4583,8 +4631,11 @@ void CodeGenerator::GenericBinaryOperation(Token::Value op,
 
     default:
       // By default only inline the Smi check code for likely smis if this
-      // operation is part of a loop.
-      flags = ((loop_nesting() > 0) && type->IsLikelySmi())
+      // operation is part of a loop.  Hot functions recompiled by the
+      // optimizing compiler inline it for all operations; the stub is
+      // the fallback when the operands turn out not to be smis.
+      flags = ((loop_nesting() > 0) &&
+               (type->IsLikelySmi() || is_optimizing()))
               ? SMI_CODE_INLINED
               : SMI_CODE_IN_STUB;
       break;
@@ -4700,7 +4751,7 @@ void DeferredReferenceGetNamedValue::Generate() {
   int delta_to_patch_site = masm_->SizeOfCodeGeneratedSince(patch_site());
   // Here we use masm_-> instead of the __ macro because this is the
   // instruction that gets patched and coverage code gets in the way.
-  masm_->testq(rax, Immediate(-delta_to_patch_site));
+  masm_->testl(rax, Immediate(-delta_to_patch_site));
   __ IncrementCounter(&Counters::named_load_inline_miss, 1);
 
   if (!dst_.is(rax)) __ movq(dst_, rax);
@@ -5223,6 +5274,13 @@ void Reference::GetValue(TypeofState typeof_state) {
   ASSERT(cgen_->HasValidEntryRegisters());
   ASSERT(!is_illegal());
   MacroAssembler* masm = cgen_->masm();
+
+  // Record the source position for the property load.
+  Property* property = expression_->AsProperty();
+  if (property != NULL) {
+    cgen_->CodeForSourcePosition(property->position());
+  }
+
   switch (type_) {
     case SLOT: {
       Comment cmnt(masm, "[ Load from Slot");
@@ -5267,6 +5325,14 @@ void Reference::GetValue(TypeofState typeof_state) {
         Comment cmnt(masm, "[ Inlined named property load");
         Result receiver = cgen_->frame()->Pop();
         receiver.ToRegister();
+        // Addressing off r12 needs an extra SIB byte, which would move
+        // the patched map and offset.  Use a different register instead.
+        if (receiver.reg().is(r12)) {
+          Result copy = cgen_->allocator()->Allocate();
+          ASSERT(copy.is_valid());
+          __ movq(copy.reg(), receiver.reg());
+          receiver = copy;
+        }
 
         Result value = cgen_->allocator()->Allocate();
         ASSERT(value.is_valid());
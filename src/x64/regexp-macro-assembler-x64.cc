@@ -25,3 +25,1392 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "v8.h"
+#include "unicode.h"
+#include "log.h"
+#include "ast.h"
+#include "regexp-stack.h"
+#include "macro-assembler.h"
+#include "regexp-macro-assembler.h"
+#include "x64/macro-assembler-x64.h"
+#include "x64/regexp-macro-assembler-x64.h"
+
+namespace v8 {
+namespace internal {
+
+/*
+ * This assembler uses the following register assignment convention
+ * - rdx : current character. Must be loaded using LoadCurrentCharacter
+ *         before using any of the dispatch methods.
+ * - rdi : current position in input, as negative offset from end of string.
+ *         Please notice that this is the byte offset, not the character
+ *         offset! Is always a 32-bit signed (negative) offset, but must be
+ *         maintained sign-extended to 64 bits, since it is used as index.
+ * - rsi : end of input (points to byte after last character in input),
+ *         so that rsi+rdi points to the current character.
+ * - rbp : frame pointer. Used to access arguments, local variables and
+ *         RegExp registers.
+ * - rsp : points to tip of C stack.
+ * - rcx : points to tip of backtrack stack. The backtrack stack contains
+ *         only 32-bit values. Most are offsets from some base (e.g., character
+ *         positions from end of string or code location from the Code object
+ *         pointer).
+ *
+ * The registers rax, rbx, r8, r9 and r11 are free to use for computations.
+ * r10 is the macro assembler's scratch register.
+ *
+ * Each call to a public method should retain this convention.
+ * The stack will have the following structure:
+ *       - stack_area_top     (High end of the memory area to use as
+ *                             backtracking stack)
+ *       - return address
+ * rbp-> - old rbp
+ *       - String* input_string
+ *       - int start_index    (only the low 32 bits are valid)
+ *       - Address input_start
+ *       - Address input_end
+ *       - int* capture_array (int[num_saved_registers_], for output).
+ *       - at_start           (if 1, start at start of string, if 0, don't;
+ *                             only the low 32 bits are valid)
+ *       - backup of caller rbx
+ *       - Offset of location before start of input (effectively character
+ *         position -1). Used to initialize capture registers to a non-position.
+ *       - Number of backtracks so far.
+ *       - register 0  rbp[-80]  (Only positions must be stored in the first
+ *       - register 1  rbp[-88]   num_saved_registers_ registers)
+ *       - ...
+ *
+ * The first num_saved_registers_ registers are initialized to point to
+ * "character -1" in the string (i.e., char_size() bytes before the first
+ * character of the string). The remaining registers starts out as garbage.
+ *
+ * The first six arguments are passed in registers as required by the
+ * System V AMD64 calling convention, and are stored in the frame by the
+ * entry code. The code entry is called as cast to:
+ * int (*match)(String* input_string,
+ *              int start_index,
+ *              Address start,
+ *              Address end,
+ *              int* capture_output_array,
+ *              int at_start,
+ *              byte* stack_area_top)
+ */
+
+#define __ ACCESS_MASM(masm_)
+
+RegExpMacroAssemblerX64::RegExpMacroAssemblerX64(
+    Mode mode,
+    int registers_to_save)
+    : masm_(new MacroAssembler(NULL, kRegExpCodeSize)),
+      code_relative_fixup_positions_(4),
+      mode_(mode),
+      num_registers_(registers_to_save),
+      num_saved_registers_(registers_to_save),
+      backtrack_limit_(FLAG_regexp_backtrack_limit),
+      entry_label_(),
+      start_label_(),
+      success_label_(),
+      backtrack_label_(),
+      exit_label_() {
+  __ jmp(&entry_label_);   // We'll write the entry code later.
+  __ bind(&start_label_);  // And then continue from here.
+}
+
+
+RegExpMacroAssemblerX64::~RegExpMacroAssemblerX64() {
+  delete masm_;
+  // Unuse labels in case we throw away the assembler without calling GetCode.
+  entry_label_.Unuse();
+  start_label_.Unuse();
+  success_label_.Unuse();
+  backtrack_label_.Unuse();
+  exit_label_.Unuse();
+  check_preempt_label_.Unuse();
+  stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
+}
+
+
+int RegExpMacroAssemblerX64::stack_limit_slack()  {
+  return RegExpStack::kStackLimitSlack;
+}
+
+
+void RegExpMacroAssemblerX64::AdvanceCurrentPosition(int by) {
+  if (by != 0) {
+    __ addq(rdi, Immediate(by * char_size()));
+  }
+}
+
+
+void RegExpMacroAssemblerX64::AdvanceRegister(int reg, int by) {
+  ASSERT(reg >= 0);
+  ASSERT(reg < num_registers_);
+  if (by != 0) {
+    __ addq(register_location(reg), Immediate(by));
+  }
+}
+
+
+void RegExpMacroAssemblerX64::Backtrack() {
+  CheckPreemption();
+  if (backtrack_limit_ > 0) {
+    __ incq(Operand(rbp, kBacktrackCount));
+    __ cmpq(Operand(rbp, kBacktrackCount), Immediate(backtrack_limit_));
+    __ j(greater, &backtrack_limit_label_);
+  }
+  // Pop Code* offset from backtrack stack, add Code* and jump to location.
+  Pop(rbx);
+  __ movq(kScratchRegister, masm_->CodeObject(), RelocInfo::EMBEDDED_OBJECT);
+  __ addq(rbx, kScratchRegister);
+  __ jmp(rbx);
+}
+
+
+void RegExpMacroAssemblerX64::Bind(Label* label) {
+  __ bind(label);
+}
+
+
+void RegExpMacroAssemblerX64::CheckBitmap(uc16 start,
+                                          Label* bitmap,
+                                          Label* on_zero) {
+  UNIMPLEMENTED();
+}
+
+
+void RegExpMacroAssemblerX64::CheckCharacter(uint32_t c, Label* on_equal) {
+  __ cmpl(current_character(), Immediate(c));
+  BranchOrBacktrack(equal, on_equal);
+}
+
+
+void RegExpMacroAssemblerX64::CheckCharacterGT(uc16 limit, Label* on_greater) {
+  __ cmpl(current_character(), Immediate(limit));
+  BranchOrBacktrack(greater, on_greater);
+}
+
+
+void RegExpMacroAssemblerX64::CheckAtStart(Label* on_at_start) {
+  Label not_at_start;
+  // Did we start the match at the start of the string at all?
+  __ cmpl(Operand(rbp, kAtStart), Immediate(0));
+  BranchOrBacktrack(equal, &not_at_start);
+  // If we did, are we still at the start of the input?
+  __ lea(rax, Operand(rsi, rdi, times_1, 0));
+  __ cmpq(rax, Operand(rbp, kInputStart));
+  BranchOrBacktrack(equal, on_at_start);
+  __ bind(&not_at_start);
+}
+
+
+void RegExpMacroAssemblerX64::CheckNotAtStart(Label* on_not_at_start) {
+  // Did we start the match at the start of the string at all?
+  __ cmpl(Operand(rbp, kAtStart), Immediate(0));
+  BranchOrBacktrack(equal, on_not_at_start);
+  // If we did, are we still at the start of the input?
+  __ lea(rax, Operand(rsi, rdi, times_1, 0));
+  __ cmpq(rax, Operand(rbp, kInputStart));
+  BranchOrBacktrack(not_equal, on_not_at_start);
+}
+
+
+void RegExpMacroAssemblerX64::CheckCharacterLT(uc16 limit, Label* on_less) {
+  __ cmpl(current_character(), Immediate(limit));
+  BranchOrBacktrack(less, on_less);
+}
+
+
+void RegExpMacroAssemblerX64::CheckCharacters(Vector<const uc16> str,
+                                              int cp_offset,
+                                              Label* on_failure,
+                                              bool check_end_of_string) {
+  int byte_length = str.length() * char_size();
+  int byte_offset = cp_offset * char_size();
+  if (check_end_of_string) {
+    // Check that there are at least str.length() characters left in the input.
+    __ cmpq(rdi, Immediate(-(byte_offset + byte_length)));
+    BranchOrBacktrack(greater, on_failure);
+  }
+
+  Label backtrack;
+  if (on_failure == NULL) {
+    // Avoid inlining the Backtrack macro for each test.
+    Label skip_backtrack;
+    __ jmp(&skip_backtrack);
+    __ bind(&backtrack);
+    Backtrack();
+    __ bind(&skip_backtrack);
+    on_failure = &backtrack;
+  }
+
+  for (int i = 0; i < str.length(); i++) {
+    if (mode_ == ASCII) {
+      __ cmpb(Operand(rsi, rdi, times_1, byte_offset + i),
+              Immediate(static_cast<int8_t>(str[i])));
+    } else {
+      ASSERT(mode_ == UC16);
+      __ cmpw(Operand(rsi, rdi, times_1, byte_offset + i * sizeof(uc16)),
+              Immediate(str[i]));
+    }
+    BranchOrBacktrack(not_equal, on_failure);
+  }
+}
+
+
+void RegExpMacroAssemblerX64::CheckGreedyLoop(Label* on_equal) {
+  Label fallthrough;
+  __ cmpl(rdi, Operand(backtrack_stackpointer(), 0));
+  __ j(not_equal, &fallthrough);
+  __ addq(backtrack_stackpointer(), Immediate(kIntSize));  // Pop.
+  BranchOrBacktrack(no_condition, on_equal);
+  __ bind(&fallthrough);
+}
+
+
+void RegExpMacroAssemblerX64::CheckNotBackReferenceIgnoreCase(
+    int start_reg,
+    Label* on_no_match) {
+  Label fallthrough;
+  __ movq(rdx, register_location(start_reg));  // Offset of start of capture
+  __ movq(rbx, register_location(start_reg + 1));  // Offset of end of capture
+  __ subq(rbx, rdx);  // Length of capture.
+
+  // The length of a capture should not be negative. This can only happen
+  // if the end of the capture is unrecorded, or at a point earlier than
+  // the start of the capture.
+  BranchOrBacktrack(less, on_no_match);
+
+  // If length is zero, either the capture is empty or it is completely
+  // uncaptured. In either case succeed immediately.
+  __ j(equal, &fallthrough);
+
+  // Check that there are sufficient characters left in the input.
+  __ movq(rax, rdi);
+  __ addq(rax, rbx);
+  BranchOrBacktrack(greater, on_no_match);
+
+  if (mode_ == ASCII) {
+    Label loop_increment;
+    Label fail;
+    Label convert_capture;
+
+    __ lea(r9, Operand(rsi, rdx, times_1, 0));  // Start of capture.
+    __ lea(r11, Operand(rsi, rdi, times_1, 0));  // Start of text to match.
+    __ lea(r8, Operand(r11, rbx, times_1, 0));  // End of text to match.
+
+    Label loop;
+    __ bind(&loop);
+    __ movzxbq(rax, Operand(r11, 0));
+    __ movzxbq(rdx, Operand(r9, 0));
+    __ cmpl(rax, rdx);
+    __ j(equal, &loop_increment);
+
+    // Mismatch, try case-insensitive match (converting letters to lower-case).
+    __ or_(rax, Immediate(0x20));  // Convert match character to lower-case.
+    __ lea(rdx, Operand(rax, -'a'));
+    __ cmpl(rdx, Immediate('z' - 'a'));  // Is rax a lowercase letter?
+    __ j(below_equal, &convert_capture);
+    // Latin-1 lower-case letters are \u00e0 to \u00fe, except \u00f7.
+    __ subl(rdx, Immediate(0xe0 - 'a'));
+    __ cmpl(rdx, Immediate(0xfe - 0xe0));
+    __ j(above, &fail);
+    __ cmpl(rdx, Immediate(0xf7 - 0xe0));
+    __ j(equal, &fail);
+    __ bind(&convert_capture);
+    // Also convert capture character.
+    __ movzxbq(rdx, Operand(r9, 0));
+    __ or_(rdx, Immediate(0x20));
+
+    __ cmpl(rax, rdx);
+    __ j(not_equal, &fail);
+
+    __ bind(&loop_increment);
+    // Increment pointers into match and capture strings.
+    __ addq(r9, Immediate(1));
+    __ addq(r11, Immediate(1));
+    // Compare to end of match, and loop if not done.
+    __ cmpq(r11, r8);
+    __ j(below, &loop);
+
+    // Compute new value of character position after the matched part.
+    __ movq(rdi, r11);
+    __ subq(rdi, rsi);
+    __ jmp(&fallthrough);
+
+    __ bind(&fail);
+    BranchOrBacktrack(no_condition, on_no_match);
+  } else {
+    ASSERT(mode_ == UC16);
+    // Save registers before calling C function. rbx is callee-saved and
+    // keeps the length of the capture across the call.
+    __ push(rsi);
+    __ push(rdi);
+    __ push(backtrack_stackpointer());
+
+    const int argument_count = 3;
+    FrameAlign(argument_count, rax);
+    // Parameters are
+    //   Address byte_offset1 - Address captured substring's start.
+    //   Address byte_offset2 - Address of current character position.
+    //   size_t byte_length - length of capture in bytes(!)
+
+    // Found by adding negative string-end offset of capture start (rdx)
+    // and of current position (rdi) to end of string.
+    __ lea(rax, Operand(rsi, rdx, times_1, 0));
+    __ lea(rsi, Operand(rsi, rdi, times_1, 0));
+    __ movq(rdi, rax);
+    __ movq(rdx, rbx);
+
+    Address function_address = FUNCTION_ADDR(&CaseInsensitiveCompareUC16);
+    CallCFunction(function_address, argument_count);
+    // Pop original values before reacting on result value.
+    __ pop(backtrack_stackpointer());
+    __ pop(rdi);
+    __ pop(rsi);
+
+    // Check if function returned non-zero for success or zero for failure.
+    __ testq(rax, rax);
+    BranchOrBacktrack(zero, on_no_match);
+    // On success, increment position by length of capture.
+    __ addq(rdi, rbx);
+  }
+  __ bind(&fallthrough);
+}
+
+
+void RegExpMacroAssemblerX64::CheckNotBackReference(
+    int start_reg,
+    Label* on_no_match) {
+  Label fallthrough;
+
+  // Find length of back-referenced capture.
+  __ movq(rdx, register_location(start_reg));
+  __ movq(rax, register_location(start_reg + 1));
+  __ subq(rax, rdx);  // Length to check.
+  // Fail on partial or illegal capture (start of capture after end of capture).
+  BranchOrBacktrack(less, on_no_match);
+  // Succeed on empty capture (including no capture)
+  __ j(equal, &fallthrough);
+
+  // Check that there are sufficient characters left in the input.
+  __ movq(rbx, rdi);
+  __ addq(rbx, rax);
+  BranchOrBacktrack(greater, on_no_match);
+
+  // Compute pointers to match string and capture string
+  __ lea(rbx, Operand(rsi, rdi, times_1, 0));  // Start of match.
+  __ addq(rdx, rsi);  // Start of capture.
+  __ lea(r9, Operand(rax, rbx, times_1, 0));  // End of match.
+
+  Label loop;
+  __ bind(&loop);
+  if (mode_ == ASCII) {
+    __ movzxbq(rax, Operand(rdx, 0));
+    __ movzxbq(r11, Operand(rbx, 0));
+  } else {
+    ASSERT(mode_ == UC16);
+    __ movzxwq(rax, Operand(rdx, 0));
+    __ movzxwq(r11, Operand(rbx, 0));
+  }
+  __ cmpl(rax, r11);
+  BranchOrBacktrack(not_equal, on_no_match);
+  // Increment pointers into capture and match string.
+  __ addq(rdx, Immediate(char_size()));
+  __ addq(rbx, Immediate(char_size()));
+  // Check if we have reached end of match area.
+  __ cmpq(rbx, r9);
+  __ j(below, &loop);
+
+  // Move current character position to position after match.
+  __ movq(rdi, r9);
+  __ subq(rdi, rsi);
+
+  __ bind(&fallthrough);
+}
+
+
+void RegExpMacroAssemblerX64::CheckNotRegistersEqual(int reg1,
+                                                     int reg2,
+                                                     Label* on_not_equal) {
+  __ movq(rax, register_location(reg1));
+  __ cmpq(rax, register_location(reg2));
+  BranchOrBacktrack(not_equal, on_not_equal);
+}
+
+
+void RegExpMacroAssemblerX64::CheckNotCharacter(uint32_t c,
+                                                Label* on_not_equal) {
+  __ cmpl(current_character(), Immediate(c));
+  BranchOrBacktrack(not_equal, on_not_equal);
+}
+
+
+void RegExpMacroAssemblerX64::CheckCharacterAfterAnd(uint32_t c,
+                                                     uint32_t mask,
+                                                     Label* on_equal) {
+  __ movl(rax, current_character());
+  __ and_(rax, Immediate(mask));
+  __ cmpl(rax, Immediate(c));
+  BranchOrBacktrack(equal, on_equal);
+}
+
+
+void RegExpMacroAssemblerX64::CheckNotCharacterAfterAnd(uint32_t c,
+                                                        uint32_t mask,
+                                                        Label* on_not_equal) {
+  __ movl(rax, current_character());
+  __ and_(rax, Immediate(mask));
+  __ cmpl(rax, Immediate(c));
+  BranchOrBacktrack(not_equal, on_not_equal);
+}
+
+
+void RegExpMacroAssemblerX64::CheckNotCharacterAfterMinusAnd(
+    uc16 c,
+    uc16 minus,
+    uc16 mask,
+    Label* on_not_equal) {
+  ASSERT(minus < String::kMaxUC16CharCode);
+  __ lea(rax, Operand(current_character(), -minus));
+  __ and_(rax, Immediate(mask));
+  __ cmpl(rax, Immediate(c));
+  BranchOrBacktrack(not_equal, on_not_equal);
+}
+
+
+bool RegExpMacroAssemblerX64::CheckSpecialCharacterClass(uc16 type,
+                                                         int cp_offset,
+                                                         bool check_offset,
+                                                         Label* on_no_match) {
+  // Range checks (c in min..max) are generally implemented by an unsigned
+  // (c - min) <= (max - min) check
+  switch (type) {
+  case 's':
+    // Match space-characters
+    if (mode_ == ASCII) {
+      // Latin-1 space characters are '\t'..'\r', ' ' and \u00a0.
+      if (check_offset) {
+        LoadCurrentCharacter(cp_offset, on_no_match);
+      } else {
+        LoadCurrentCharacterUnchecked(cp_offset, 1);
+      }
+      Label success;
+      __ cmpl(current_character(), Immediate(' '));
+      __ j(equal, &success);
+      // Check range 0x09..0x0d
+      __ subl(current_character(), Immediate('\t'));
+      __ cmpl(current_character(), Immediate('\r' - '\t'));
+      __ j(below_equal, &success);
+      __ cmpl(current_character(), Immediate(0x00a0 - '\t'));
+      BranchOrBacktrack(not_equal, on_no_match);
+      __ bind(&success);
+      return true;
+    }
+    return false;
+  case 'S':
+    // Match non-space characters.
+    if (check_offset) {
+      LoadCurrentCharacter(cp_offset, on_no_match, 1);
+    } else {
+      LoadCurrentCharacterUnchecked(cp_offset, 1);
+    }
+    if (mode_ == ASCII) {
+      // Latin-1 space characters are '\t'..'\r', ' ' and \u00a0.
+      __ cmpl(current_character(), Immediate(' '));
+      BranchOrBacktrack(equal, on_no_match);
+      __ subl(current_character(), Immediate('\t'));
+      __ cmpl(current_character(), Immediate('\r' - '\t'));
+      BranchOrBacktrack(below_equal, on_no_match);
+      __ cmpl(current_character(), Immediate(0x00a0 - '\t'));
+      BranchOrBacktrack(equal, on_no_match);
+      return true;
+    }
+    return false;
+  case 'd':
+    // Match ASCII digits ('0'..'9')
+    if (check_offset) {
+      LoadCurrentCharacter(cp_offset, on_no_match, 1);
+    } else {
+      LoadCurrentCharacterUnchecked(cp_offset, 1);
+    }
+    __ subl(current_character(), Immediate('0'));
+    __ cmpl(current_character(), Immediate('9' - '0'));
+    BranchOrBacktrack(above, on_no_match);
+    return true;
+  case 'D':
+    // Match non ASCII-digits
+    if (check_offset) {
+      LoadCurrentCharacter(cp_offset, on_no_match, 1);
+    } else {
+      LoadCurrentCharacterUnchecked(cp_offset, 1);
+    }
+    __ subl(current_character(), Immediate('0'));
+    __ cmpl(current_character(), Immediate('9' - '0'));
+    BranchOrBacktrack(below_equal, on_no_match);
+    return true;
+  case '.': {
+    // Match non-newlines (not 0x0a('\n'), 0x0d('\r'), 0x2028 and 0x2029)
+    if (check_offset) {
+      LoadCurrentCharacter(cp_offset, on_no_match, 1);
+    } else {
+      LoadCurrentCharacterUnchecked(cp_offset, 1);
+    }
+    __ xor_(current_character(), Immediate(0x01));
+    // See if current character is '\n'^1 or '\r'^1, i.e., 0x0b or 0x0c
+    __ subl(current_character(), Immediate(0x0b));
+    __ cmpl(current_character(), Immediate(0x0c - 0x0b));
+    BranchOrBacktrack(below_equal, on_no_match);
+    if (mode_ == UC16) {
+      // Compare original value to 0x2028 and 0x2029, using the already
+      // computed (current_char ^ 0x01 - 0x0b). I.e., check for
+      // 0x201d (0x2028 - 0x0b) or 0x201e.
+      __ subl(current_character(), Immediate(0x2028 - 0x0b));
+      __ cmpl(current_character(), Immediate(1));
+      BranchOrBacktrack(below_equal, on_no_match);
+    }
+    return true;
+  }
+  case '*':
+    // Match any character.
+    if (check_offset) {
+      CheckPosition(cp_offset, on_no_match);
+    }
+    return true;
+  // No custom implementation (yet): w, W, s(UC16), S(UC16).
+  default:
+    return false;
+  }
+}
+
+void RegExpMacroAssemblerX64::DispatchHalfNibbleMap(
+    uc16 start,
+    Label* half_nibble_map,
+    const Vector<Label*>& destinations) {
+  UNIMPLEMENTED();
+}
+
+
+void RegExpMacroAssemblerX64::DispatchByteMap(
+    uc16 start,
+    Label* byte_map,
+    const Vector<Label*>& destinations) {
+  UNIMPLEMENTED();
+}
+
+
+void RegExpMacroAssemblerX64::DispatchHighByteMap(
+    byte start,
+    Label* byte_map,
+    const Vector<Label*>& destinations) {
+  UNIMPLEMENTED();
+}
+
+
+void RegExpMacroAssemblerX64::EmitOrLink(Label* label) {
+  UNIMPLEMENTED();  // Has no use.
+}
+
+
+void RegExpMacroAssemblerX64::Fail() {
+  ASSERT(FAILURE == 0);  // Return value for failure is zero.
+  __ xor_(rax, rax);  // zero rax.
+  __ jmp(&exit_label_);
+}
+
+
+Handle<Object> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
+  // Finalize code - write the entry point code now we know how many
+  // registers we need.
+
+  // Entry code:
+  __ bind(&entry_label_);
+  // Start new stack frame.
+  __ push(rbp);
+  __ movq(rbp, rsp);
+  // Store the register arguments in the frame. Order here should correspond
+  // to order of kInputString etc.
+  __ push(rdi);
+  __ push(rsi);
+  __ push(rdx);
+  __ push(rcx);
+  __ push(r8);
+  __ push(r9);
+  __ push(rbx);  // Callee-save.
+  __ push(Immediate(0));  // Make room for "input start - 1" constant.
+  __ push(Immediate(0));  // The backtrack count starts at zero.
+
+  // Check if we have space on the stack for registers.
+  Label stack_limit_hit;
+  Label stack_ok;
+
+  ExternalReference stack_guard_limit =
+      ExternalReference::address_of_stack_guard_limit();
+  __ movq(rcx, rsp);
+  __ movq(kScratchRegister, stack_guard_limit);
+  __ subq(rcx, Operand(kScratchRegister, 0));
+  // Handle it if the stack pointer is already below the stack limit.
+  __ j(below_equal, &stack_limit_hit);
+  // Check if there is room for the variable number of registers above
+  // the stack limit.
+  __ cmpq(rcx, Immediate(num_registers_ * kPointerSize));
+  __ j(above_equal, &stack_ok);
+  // Exit with OutOfMemory exception. There is not enough space on the stack
+  // for our working registers.
+  __ movq(rax, Immediate(EXCEPTION));
+  __ jmp(&exit_label_);
+
+  __ bind(&stack_limit_hit);
+  CallCheckStackGuardState();
+  __ testq(rax, rax);
+  // If returned value is non-zero, we exit with the returned value as result.
+  __ j(not_zero, &exit_label_);
+
+  __ bind(&stack_ok);
+
+  // Allocate space on stack for registers.
+  __ subq(rsp, Immediate(num_registers_ * kPointerSize));
+  // Load string length.
+  __ movq(rsi, Operand(rbp, kInputEnd));
+  // Load input position.
+  __ movq(rdi, Operand(rbp, kInputStart));
+  // Set up rdi to be negative offset from string end.
+  __ subq(rdi, rsi);
+  // Set rax to address of char before start of input
+  // (effectively string position -1).
+  __ lea(rax, Operand(rdi, -char_size()));
+  // Store this value in a local variable, for use when clearing
+  // position registers.
+  __ movq(Operand(rbp, kInputStartMinusOne), rax);
+  if (num_saved_registers_ > 0) {
+    // Fill saved registers with initial value = start offset - 1
+    // Fill in stack push order, to avoid accessing across an unwritten
+    // page (a problem on Windows).
+    __ movq(rcx, Immediate(kRegisterZero));
+    Label init_loop;
+    __ bind(&init_loop);
+    __ movq(Operand(rbp, rcx, times_1, 0), rax);
+    __ subq(rcx, Immediate(kPointerSize));
+    __ cmpq(rcx,
+            Immediate(kRegisterZero - num_saved_registers_ * kPointerSize));
+    __ j(greater, &init_loop);
+  }
+  // Ensure that we have written to each stack page, in order. Skipping a page
+  // on Windows can cause segmentation faults. Assuming page size is 4k.
+  const int kPageSize = 4096;
+  const int kRegistersPerPage = kPageSize / kPointerSize;
+  for (int i = num_saved_registers_ + kRegistersPerPage - 1;
+      i < num_registers_;
+      i += kRegistersPerPage) {
+    __ movq(register_location(i), rax);  // One write every page.
+  }
+
+  // Initialize backtrack stack pointer.
+  __ movq(backtrack_stackpointer(), Operand(rbp, kStackHighEnd));
+  // Load previous char as initial value of current-character.
+  Label at_start;
+  __ cmpl(Operand(rbp, kAtStart), Immediate(0));
+  __ j(not_equal, &at_start);
+  LoadCurrentCharacterUnchecked(-1, 1);  // Load previous char.
+  __ jmp(&start_label_);
+  __ bind(&at_start);
+  __ movq(current_character(), Immediate('\n'));
+  __ jmp(&start_label_);
+
+
+  // Exit code:
+  if (success_label_.is_linked()) {
+    // Save captures when successful.
+    __ bind(&success_label_);
+    if (num_saved_registers_ > 0) {
+      // copy captures to output
+      __ movq(rbx, Operand(rbp, kRegisterOutput));
+      __ movq(rcx, Operand(rbp, kInputEnd));
+      __ subq(rcx, Operand(rbp, kInputStart));
+      for (int i = 0; i < num_saved_registers_; i++) {
+        __ movq(rax, register_location(i));
+        __ addq(rax, rcx);  // Convert to index from start, not end.
+        if (mode_ == UC16) {
+          __ sar(rax, Immediate(1));  // Convert byte index to character index.
+        }
+        __ movl(Operand(rbx, i * kIntSize), rax);
+      }
+    }
+    __ movq(rax, Immediate(SUCCESS));
+  }
+  // Exit and return rax
+  __ bind(&exit_label_);
+  // Restore callee-save register.
+  __ movq(rbx, Operand(rbp, kBackup_rbx));
+  // Skip rsp past regexp registers and exit function frame, restore
+  // previous one.
+  __ movq(rsp, rbp);
+  __ pop(rbp);
+  __ ret(0);
+
+  // Backtrack code (branch target for conditional backtracks).
+  if (backtrack_label_.is_linked()) {
+    __ bind(&backtrack_label_);
+    Backtrack();
+  }
+
+  Label exit_with_exception;
+
+  // Preempt-code
+  if (check_preempt_label_.is_linked()) {
+    SafeCallTarget(&check_preempt_label_);
+
+    __ push(backtrack_stackpointer());
+    __ push(rdi);
+
+    CallCheckStackGuardState();
+    __ testq(rax, rax);
+    // If returning non-zero, we should end execution with the given
+    // result as return value.
+    __ j(not_zero, &exit_label_);
+
+    __ pop(rdi);
+    __ pop(backtrack_stackpointer());
+    // String might have moved: Reload rsi from frame.
+    __ movq(rsi, Operand(rbp, kInputEnd));
+    SafeReturn();
+  }
+
+  // Backtrack stack overflow code.
+  if (stack_overflow_label_.is_linked()) {
+    SafeCallTarget(&stack_overflow_label_);
+    // Reached if the backtrack-stack limit has been hit.
+
+    // Save registers before calling C function
+    __ push(rsi);
+    __ push(rdi);
+    __ push(current_character());
+
+    // Call GrowStack(backtrack_stackpointer(), &stack_area_top)
+    int num_arguments = 2;
+    FrameAlign(num_arguments, rax);
+    __ movq(rdi, backtrack_stackpointer());
+    __ lea(rsi, Operand(rbp, kStackHighEnd));
+    CallCFunction(FUNCTION_ADDR(&GrowStack), num_arguments);
+    // If return NULL, we have failed to grow the stack, and
+    // must exit with a stack-overflow exception.
+    __ testq(rax, rax);
+    __ j(equal, &exit_with_exception);
+    // Otherwise use return value as new stack pointer.
+    __ movq(backtrack_stackpointer(), rax);
+    // Restore saved registers and continue.
+    __ pop(current_character());
+    __ pop(rdi);
+    __ pop(rsi);
+    SafeReturn();
+  }
+
+  if (backtrack_limit_label_.is_linked()) {
+    __ bind(&backtrack_limit_label_);
+    __ movq(rax, Immediate(kBacktrackLimitExceeded));
+    __ jmp(&exit_label_);
+  }
+
+  if (exit_with_exception.is_linked()) {
+    // If any of the code above needed to exit with an exception.
+    __ bind(&exit_with_exception);
+    // Exit with Result EXCEPTION(-1) to signal thrown exception.
+    __ movq(rax, Immediate(EXCEPTION));
+    __ jmp(&exit_label_);
+  }
+
+  FixupCodeRelativePositions();
+
+  CodeDesc code_desc;
+  masm_->GetCode(&code_desc);
+  Handle<Code> code = Factory::NewCode(code_desc,
+                                       NULL,
+                                       Code::ComputeFlags(Code::REGEXP),
+                                       masm_->CodeObject());
+  LOG(RegExpCodeCreateEvent(*code, *source));
+  return Handle<Object>::cast(code);
+}
+
+
+void RegExpMacroAssemblerX64::GoTo(Label* to) {
+  BranchOrBacktrack(no_condition, to);
+}
+
+
+void RegExpMacroAssemblerX64::IfRegisterGE(int reg,
+                                           int comparand,
+                                           Label* if_ge) {
+  __ cmpq(register_location(reg), Immediate(comparand));
+  BranchOrBacktrack(greater_equal, if_ge);
+}
+
+
+void RegExpMacroAssemblerX64::IfRegisterLT(int reg,
+                                           int comparand,
+                                           Label* if_lt) {
+  __ cmpq(register_location(reg), Immediate(comparand));
+  BranchOrBacktrack(less, if_lt);
+}
+
+
+void RegExpMacroAssemblerX64::IfRegisterEqPos(int reg,
+                                              Label* if_eq) {
+  __ cmpq(rdi, register_location(reg));
+  BranchOrBacktrack(equal, if_eq);
+}
+
+
+RegExpMacroAssembler::IrregexpImplementation
+    RegExpMacroAssemblerX64::Implementation() {
+  return kX64Implementation;
+}
+
+
+void RegExpMacroAssemblerX64::LoadCurrentCharacter(int cp_offset,
+                                                   Label* on_end_of_input,
+                                                   bool check_bounds,
+                                                   int characters) {
+  ASSERT(cp_offset >= -1);      // ^ and \b can look behind one character.
+  ASSERT(cp_offset < (1<<30));  // Be sane! (And ensure negation works)
+  CheckPosition(cp_offset + characters - 1, on_end_of_input);
+  LoadCurrentCharacterUnchecked(cp_offset, characters);
+}
+
+
+void RegExpMacroAssemblerX64::PopCurrentPosition() {
+  Pop(rdi);
+}
+
+
+void RegExpMacroAssemblerX64::PopRegister(int register_index) {
+  Pop(rax);
+  __ movq(register_location(register_index), rax);
+}
+
+
+void RegExpMacroAssemblerX64::PushBacktrack(Label* label) {
+  Push(label);
+  CheckStackLimit();
+}
+
+
+void RegExpMacroAssemblerX64::PushCurrentPosition() {
+  Push(rdi);
+}
+
+
+void RegExpMacroAssemblerX64::PushRegister(int register_index,
+                                           StackCheckFlag check_stack_limit) {
+  __ movq(rax, register_location(register_index));
+  Push(rax);
+  if (check_stack_limit) CheckStackLimit();
+}
+
+
+void RegExpMacroAssemblerX64::ReadCurrentPositionFromRegister(int reg) {
+  __ movq(rdi, register_location(reg));
+}
+
+
+void RegExpMacroAssemblerX64::ReadStackPointerFromRegister(int reg) {
+  __ movq(backtrack_stackpointer(), register_location(reg));
+  __ addq(backtrack_stackpointer(), Operand(rbp, kStackHighEnd));
+}
+
+
+void RegExpMacroAssemblerX64::SetRegister(int register_index, int to) {
+  ASSERT(register_index >= num_saved_registers_);  // Reserved for positions!
+  __ movq(register_location(register_index), Immediate(to));
+}
+
+
+void RegExpMacroAssemblerX64::Succeed() {
+  __ jmp(&success_label_);
+}
+
+
+void RegExpMacroAssemblerX64::WriteCurrentPositionToRegister(int reg,
+                                                             int cp_offset) {
+  if (cp_offset == 0) {
+    __ movq(register_location(reg), rdi);
+  } else {
+    __ lea(rax, Operand(rdi, cp_offset * char_size()));
+    __ movq(register_location(reg), rax);
+  }
+}
+
+
+void RegExpMacroAssemblerX64::ClearRegisters(int reg_from, int reg_to) {
+  ASSERT(reg_from <= reg_to);
+  __ movq(rax, Operand(rbp, kInputStartMinusOne));
+  for (int reg = reg_from; reg <= reg_to; reg++) {
+    __ movq(register_location(reg), rax);
+  }
+}
+
+
+void RegExpMacroAssemblerX64::WriteStackPointerToRegister(int reg) {
+  __ movq(rax, backtrack_stackpointer());
+  __ subq(rax, Operand(rbp, kStackHighEnd));
+  __ movq(register_location(reg), rax);
+}
+
+
+RegExpMacroAssemblerX64::Result RegExpMacroAssemblerX64::Match(
+    Handle<Code> regexp_code,
+    Handle<String> subject,
+    int* offsets_vector,
+    int offsets_vector_length,
+    int previous_index) {
+
+  ASSERT(subject->IsFlat());
+  ASSERT(previous_index >= 0);
+  ASSERT(previous_index <= subject->length());
+
+  // No allocations before calling the regexp, but we can't use
+  // AssertNoAllocation, since regexps might be preempted, and another thread
+  // might do allocation anyway.
+
+  String* subject_ptr = *subject;
+  // Character offsets into string.
+  int start_offset = previous_index;
+  int end_offset = subject_ptr->length();
+
+  bool is_ascii = subject->IsAsciiRepresentation();
+
+  if (StringShape(subject_ptr).IsCons()) {
+    subject_ptr = ConsString::cast(subject_ptr)->first();
+  } else if (StringShape(subject_ptr).IsSliced()) {
+    SlicedString* slice = SlicedString::cast(subject_ptr);
+    start_offset += slice->start();
+    end_offset += slice->start();
+    subject_ptr = slice->buffer();
+  }
+  // Ensure that an underlying string has the same ascii-ness.
+  ASSERT(subject_ptr->IsAsciiRepresentation() == is_ascii);
+  ASSERT(subject_ptr->IsExternalString() || subject_ptr->IsSeqString());
+  // String is now either Sequential or External
+  int char_size_shift = is_ascii ? 0 : 1;
+  int char_length = end_offset - start_offset;
+
+  const byte* input_start =
+      StringCharacterPosition(subject_ptr, start_offset);
+  int byte_length = char_length << char_size_shift;
+  const byte* input_end = input_start + byte_length;
+  RegExpMacroAssemblerX64::Result res = Execute(*regexp_code,
+                                                subject_ptr,
+                                                start_offset,
+                                                input_start,
+                                                input_end,
+                                                offsets_vector,
+                                                previous_index == 0);
+
+  if (res == SUCCESS) {
+    // Capture values are relative to start_offset only.
+    // Convert them to be relative to start of string.
+    for (int i = 0; i < offsets_vector_length; i++) {
+      if (offsets_vector[i] >= 0) {
+        offsets_vector[i] += previous_index;
+      }
+    }
+  }
+
+  return res;
+}
+
+// Private methods:
+
+static unibrow::Mapping<unibrow::Ecma262Canonicalize> canonicalize;
+
+RegExpMacroAssemblerX64::Result RegExpMacroAssemblerX64::Execute(
+    Code* code,
+    String* input,
+    int start_offset,
+    const byte* input_start,
+    const byte* input_end,
+    int* output,
+    bool at_start) {
+  typedef int (*matcher)(String*, int, const byte*,
+                         const byte*, int*, int, Address);
+  matcher matcher_func = FUNCTION_CAST<matcher>(code->entry());
+
+  int at_start_val = at_start ? 1 : 0;
+
+  // Ensure that the minimum stack has been allocated.
+  RegExpStack stack;
+  Address stack_top = RegExpStack::stack_top();
+
+  int result = matcher_func(input,
+                            start_offset,
+                            input_start,
+                            input_end,
+                            output,
+                            at_start_val,
+                            stack_top);
+  if (result == kBacktrackLimitExceeded) {
+    RegExpImpl::ThrowBacktrackLimitExceeded();
+    return EXCEPTION;
+  }
+  ASSERT(result <= SUCCESS);
+  ASSERT(result >= RETRY);
+
+  if (result == EXCEPTION && !Top::has_pending_exception()) {
+    // We detected a stack overflow (on the backtrack stack) in RegExp code,
+    // but haven't created the exception yet.
+    Top::StackOverflow();
+  }
+  return static_cast<Result>(result);
+}
+
+
+int RegExpMacroAssemblerX64::CaseInsensitiveCompareUC16(Address byte_offset1,
+                                                        Address byte_offset2,
+                                                        size_t byte_length) {
+  // This function is not allowed to cause a garbage collection.
+  // A GC might move the calling generated code and invalidate the
+  // return address on the stack.
+  ASSERT(byte_length % 2 == 0);
+  uc16* substring1 = reinterpret_cast<uc16*>(byte_offset1);
+  uc16* substring2 = reinterpret_cast<uc16*>(byte_offset2);
+  size_t length = byte_length >> 1;
+
+  for (size_t i = 0; i < length; i++) {
+    unibrow::uchar c1 = substring1[i];
+    unibrow::uchar c2 = substring2[i];
+    if (c1 != c2) {
+      if (c1 < 128 || c2 < 128) {
+        if (!AsciiCaseIndependentEquals(c1, c2)) return 0;
+        continue;
+      }
+      canonicalize.get(c1, '\0', &c1);
+      if (c1 != c2) {
+        canonicalize.get(c2, '\0', &c2);
+        if (c1 != c2) {
+          return 0;
+        }
+      }
+    }
+  }
+  return 1;
+}
+
+
+void RegExpMacroAssemblerX64::CallCheckStackGuardState() {
+  // This function call preserves no register values. Caller should
+  // store anything volatile in a C call or overwritten by this function.
+  int num_arguments = 3;
+  FrameAlign(num_arguments, rax);
+  // RegExp code frame pointer.
+  __ movq(rdx, rbp);
+  // Code* of self.
+  __ movq(rsi, masm_->CodeObject(), RelocInfo::EMBEDDED_OBJECT);
+  // Next address on the stack (will be address of return address).
+  __ lea(rdi, Operand(rsp, -kPointerSize));
+  CallCFunction(FUNCTION_ADDR(&CheckStackGuardState), num_arguments);
+}
+
+
+// Helper function for reading a value out of a stack frame.
+template <typename T>
+static T& frame_entry(Address re_frame, int frame_offset) {
+  return *reinterpret_cast<T*>(re_frame + frame_offset);
+}
+
+
+const byte* RegExpMacroAssemblerX64::StringCharacterPosition(String* subject,
+                                                             int start_index) {
+  // Not just flat, but ultra flat.
+  ASSERT(subject->IsExternalString() || subject->IsSeqString());
+  ASSERT(start_index >= 0);
+  ASSERT(start_index <= subject->length());
+  if (subject->IsAsciiRepresentation()) {
+    const byte* address;
+    if (StringShape(subject).IsExternal()) {
+      const char* data = ExternalAsciiString::cast(subject)->resource()->data();
+      address = reinterpret_cast<const byte*>(data);
+    } else {
+      ASSERT(subject->IsSeqAsciiString());
+      char* data = SeqAsciiString::cast(subject)->GetChars();
+      address = reinterpret_cast<const byte*>(data);
+    }
+    return address + start_index;
+  }
+  const uc16* data;
+  if (StringShape(subject).IsExternal()) {
+    data = ExternalTwoByteString::cast(subject)->resource()->data();
+  } else {
+    ASSERT(subject->IsSeqTwoByteString());
+    data = SeqTwoByteString::cast(subject)->GetChars();
+  }
+  return reinterpret_cast<const byte*>(data + start_index);
+}
+
+
+int RegExpMacroAssemblerX64::CheckStackGuardState(Address* return_address,
+                                                  Code* re_code,
+                                                  Address re_frame) {
+  if (StackGuard::IsStackOverflow()) {
+    Top::StackOverflow();
+    return EXCEPTION;
+  }
+
+  // If not real stack overflow the stack guard was used to interrupt
+  // execution for another purpose.
+
+  // Prepare for possible GC.
+  HandleScope handles;
+  Handle<Code> code_handle(re_code);
+
+  Handle<String> subject(frame_entry<String*>(re_frame, kInputString));
+  // Current string.
+  bool is_ascii = subject->IsAsciiRepresentation();
+
+  ASSERT(re_code->instruction_start() <= *return_address);
+  ASSERT(*return_address <=
+      re_code->instruction_start() + re_code->instruction_size());
+
+  Object* result = Execution::HandleStackGuardInterrupt();
+
+  if (*code_handle != re_code) {  // Return address no longer valid
+    intptr_t delta = *code_handle - re_code;
+    // Overwrite the return address on the stack.
+    *return_address += delta;
+  }
+
+  if (result->IsException()) {
+    return EXCEPTION;
+  }
+
+  // String might have changed.
+  if (subject->IsAsciiRepresentation() != is_ascii) {
+    // If we changed between an ASCII and an UC16 string, the specialized
+    // code cannot be used, and we need to restart regexp matching from
+    // scratch (including, potentially, compiling a new version of the code).
+    return RETRY;
+  }
+
+  // Otherwise, the content of the string might have moved. It must still
+  // be a sequential or external string with the same content.
+  // Update the start and end pointers in the stack frame to the current
+  // location (whether it has actually moved or not).
+  ASSERT(StringShape(*subject).IsSequential() ||
+      StringShape(*subject).IsExternal());
+
+  // The original start address of the characters to match.
+  const byte* start_address = frame_entry<const byte*>(re_frame, kInputStart);
+
+  // Find the current start address of the same character at the current string
+  // position.
+  int start_index = frame_entry<int>(re_frame, kStartIndex);
+  const byte* new_address = StringCharacterPosition(*subject, start_index);
+
+  if (start_address != new_address) {
+    // If there is a difference, update the object pointer and start and end
+    // addresses in the RegExp stack frame to match the new value.
+    const byte* end_address = frame_entry<const byte* >(re_frame, kInputEnd);
+    int byte_length = end_address - start_address;
+    frame_entry<const String*>(re_frame, kInputString) = *subject;
+    frame_entry<const byte*>(re_frame, kInputStart) = new_address;
+    frame_entry<const byte*>(re_frame, kInputEnd) = new_address + byte_length;
+  }
+
+  return 0;
+}
+
+
+Address RegExpMacroAssemblerX64::GrowStack(Address stack_pointer,
+                                           Address* stack_top) {
+  size_t size = RegExpStack::stack_capacity();
+  Address old_stack_top = RegExpStack::stack_top();
+  ASSERT(old_stack_top == *stack_top);
+  ASSERT(stack_pointer <= old_stack_top);
+  ASSERT(static_cast<size_t>(old_stack_top - stack_pointer) <= size);
+  Address new_stack_top = RegExpStack::EnsureCapacity(size * 2);
+  if (new_stack_top == NULL) {
+    return NULL;
+  }
+  *stack_top = new_stack_top;
+  return new_stack_top - (old_stack_top - stack_pointer);
+}
+
+
+Operand RegExpMacroAssemblerX64::register_location(int register_index) {
+  ASSERT(register_index < (1<<30));
+  if (num_registers_ <= register_index) {
+    num_registers_ = register_index + 1;
+  }
+  return Operand(rbp, kRegisterZero - register_index * kPointerSize);
+}
+
+
+void RegExpMacroAssemblerX64::CheckPosition(int cp_offset,
+                                            Label* on_outside_input) {
+  __ cmpq(rdi, Immediate(-cp_offset * char_size()));
+  BranchOrBacktrack(greater_equal, on_outside_input);
+}
+
+
+void RegExpMacroAssemblerX64::BranchOrBacktrack(Condition condition,
+                                                Label* to) {
+  if (condition < 0) {  // No condition
+    if (to == NULL) {
+      Backtrack();
+      return;
+    }
+    __ jmp(to);
+    return;
+  }
+  if (to == NULL) {
+    __ j(condition, &backtrack_label_);
+    return;
+  }
+  __ j(condition, to);
+}
+
+
+void RegExpMacroAssemblerX64::FixupCodeRelativePositions() {
+  for (int i = 0, n = code_relative_fixup_positions_.length(); i < n; i++) {
+    int position = code_relative_fixup_positions_[i];
+    // The position succeeds a 32-bit displacement of a label from the
+    // position. Turn it into the label's offset from the tagged Code pointer.
+    int patch_position = position - kIntSize;
+    int offset = masm_->long_at(patch_position);
+    masm_->long_at_put(patch_position,
+                       offset + position + Code::kHeaderSize - kHeapObjectTag);
+  }
+  code_relative_fixup_positions_.Clear();
+}
+
+
+void RegExpMacroAssemblerX64::SafeCall(Label* to) {
+  __ call(to);
+}
+
+
+void RegExpMacroAssemblerX64::SafeCallTarget(Label* label) {
+  __ bind(label);
+  // Turn the absolute return address into an offset from the Code object,
+  // so a GC moving the code while we are away does not invalidate it.
+  __ movq(kScratchRegister, masm_->CodeObject(), RelocInfo::EMBEDDED_OBJECT);
+  __ subq(Operand(rsp, 0), kScratchRegister);
+}
+
+
+void RegExpMacroAssemblerX64::SafeReturn() {
+  __ movq(kScratchRegister, masm_->CodeObject(), RelocInfo::EMBEDDED_OBJECT);
+  __ addq(Operand(rsp, 0), kScratchRegister);
+  __ ret(0);
+}
+
+
+void RegExpMacroAssemblerX64::Push(Register source) {
+  ASSERT(!source.is(backtrack_stackpointer()));
+  // Notice: This updates flags, unlike normal Push.
+  __ subq(backtrack_stackpointer(), Immediate(kIntSize));
+  __ movl(Operand(backtrack_stackpointer(), 0), source);
+}
+
+
+void RegExpMacroAssemblerX64::Push(Immediate value) {
+  // Notice: This updates flags, unlike normal Push.
+  __ subq(backtrack_stackpointer(), Immediate(kIntSize));
+  __ movl(Operand(backtrack_stackpointer(), 0), value);
+}
+
+
+void RegExpMacroAssemblerX64::Push(Label* backtrack_target) {
+  __ subq(backtrack_stackpointer(), Immediate(kIntSize));
+  __ movl(Operand(backtrack_stackpointer(), 0), backtrack_target);
+  MarkPositionForCodeRelativeLinking();
+}
+
+
+void RegExpMacroAssemblerX64::Pop(Register target) {
+  ASSERT(!target.is(backtrack_stackpointer()));
+  __ movsxlq(target, Operand(backtrack_stackpointer(), 0));
+  // Notice: This updates flags, unlike normal Pop.
+  __ addq(backtrack_stackpointer(), Immediate(kIntSize));
+}
+
+
+void RegExpMacroAssemblerX64::CheckPreemption() {
+  // Check for preemption.
+  Label no_preempt;
+  ExternalReference stack_guard_limit =
+      ExternalReference::address_of_stack_guard_limit();
+  __ movq(kScratchRegister, stack_guard_limit);
+  __ cmpq(rsp, Operand(kScratchRegister, 0));
+  __ j(above, &no_preempt);
+
+  SafeCall(&check_preempt_label_);
+
+  __ bind(&no_preempt);
+}
+
+
+void RegExpMacroAssemblerX64::CheckStackLimit() {
+  if (FLAG_check_stack) {
+    Label no_stack_overflow;
+    ExternalReference stack_limit =
+        ExternalReference::address_of_regexp_stack_limit();
+    __ movq(kScratchRegister, stack_limit);
+    __ cmpq(backtrack_stackpointer(), Operand(kScratchRegister, 0));
+    __ j(above, &no_stack_overflow);
+
+    SafeCall(&stack_overflow_label_);
+
+    __ bind(&no_stack_overflow);
+  }
+}
+
+
+void RegExpMacroAssemblerX64::FrameAlign(int num_arguments, Register scratch) {
+  // All arguments of the functions called from the generated code fit in
+  // the six argument registers.
+  ASSERT(num_arguments <= 6);
+  // Make room for the original value of rsp and align the stack, which
+  // the calling convention requires to be 16 byte aligned at the call.
+  int frame_alignment = OS::ActivationFrameAlignment();
+  ASSERT(frame_alignment != 0);
+  ASSERT(IsPowerOf2(frame_alignment));
+  __ movq(scratch, rsp);
+  __ subq(rsp, Immediate(kPointerSize));
+  __ and_(rsp, Immediate(-frame_alignment));
+  __ movq(Operand(rsp, 0), scratch);
+}
+
+
+void RegExpMacroAssemblerX64::CallCFunction(Address function_address,
+                                            int num_arguments) {
+  __ movq(rax, function_address, RelocInfo::NONE);
+  __ call(rax);
+  __ movq(rsp, Operand(rsp, 0));
+}
+
+
+void RegExpMacroAssemblerX64::LoadCurrentCharacterUnchecked(int cp_offset,
+                                                            int characters) {
+  if (mode_ == ASCII) {
+    if (characters == 4) {
+      __ movl(current_character(), Operand(rsi, rdi, times_1, cp_offset));
+    } else if (characters == 2) {
+      __ movzxwq(current_character(), Operand(rsi, rdi, times_1, cp_offset));
+    } else {
+      ASSERT(characters == 1);
+      __ movzxbq(current_character(), Operand(rsi, rdi, times_1, cp_offset));
+    }
+  } else {
+    ASSERT(mode_ == UC16);
+    if (characters == 2) {
+      __ movl(current_character(),
+              Operand(rsi, rdi, times_1, cp_offset * sizeof(uc16)));
+    } else {
+      ASSERT(characters == 1);
+      __ movzxwq(current_character(),
+                 Operand(rsi, rdi, times_1, cp_offset * sizeof(uc16)));
+    }
+  }
+}
+
+#undef __
+}}  // namespace v8::internal
@@ -0,0 +1,328 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "platform.h"
+#include "cctest.h"
+#include "diy-fp.h"
+#include "double.h"
+#include "fast-dtoa.h"
+
+using namespace v8::internal;
+
+static const int kBufferSize = 100;
+
+
+extern "C" char* dtoa(double d, int mode, int ndigits,
+                      int* decimal_point, int* sign, char** rve);
+
+extern "C" void freedtoa(char* s);
+
+
+// Deterministic random bit source for the randomized comparisons below.
+static uint32_t seed = 0x2e7a3f1;
+
+static uint32_t gen() {
+  seed = seed * 1103515245 + 12345;
+  uint32_t high = seed >> 16;
+  seed = seed * 1103515245 + 12345;
+  return (high << 16) | (seed >> 16);
+}
+
+
+static double RandomFiniteDouble() {
+  while (true) {
+    uint64_t bits = (static_cast<uint64_t>(gen()) << 32) | gen();
+    // Clear the sign; FastDtoa only accepts positive numbers.
+    Double d(bits & ~Double::kSignMask);
+    if (!d.IsSpecial() && d.value() > 0) return d.value();
+  }
+}
+
+
+// Removes trailing '0' digits the way dtoa does.
+static void TrimRepresentation(Vector<char> buffer, int* length) {
+  while (*length > 1 && buffer[*length - 1] == '0') (*length)--;
+  buffer[*length] = '\0';
+}
+
+
+// Runs FastDtoa on v and, when it succeeds, checks that the result matches
+// the digits and decimal point computed by dtoa.  Returns whether the fast
+// algorithm succeeded.
+static bool CheckAgainstDtoa(double v, FastDtoaMode mode, int digits) {
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  int length;
+  int point;
+  if (!FastDtoa(v, mode, digits, buffer, &length, &point)) return false;
+  if (mode == FAST_DTOA_PRECISION) {
+    CHECK_EQ(digits, length);
+    TrimRepresentation(buffer, &length);
+  }
+  int dtoa_point;
+  int sign;
+  char* expected = (mode == FAST_DTOA_SHORTEST)
+      ? dtoa(v, 0, 0, &dtoa_point, &sign, NULL)
+      : dtoa(v, 2, digits, &dtoa_point, &sign, NULL);
+  CHECK_EQ(expected, buffer.start());
+  CHECK_EQ(dtoa_point, point);
+  freedtoa(expected);
+  return true;
+}
+
+
+TEST(DiyFpMultiply) {
+  DiyFp diy_fp1 = DiyFp(3, 0);
+  DiyFp diy_fp2 = DiyFp(2, 0);
+  DiyFp product = DiyFp::Times(diy_fp1, diy_fp2);
+  CHECK(0 == product.f());  // NOLINT
+  CHECK_EQ(64, product.e());
+
+  diy_fp1 = DiyFp(V8_2PART_UINT64_C(0x80000000, 00000000), 11);
+  diy_fp2 = DiyFp(2, 13);
+  product = DiyFp::Times(diy_fp1, diy_fp2);
+  CHECK(1 == product.f());  // NOLINT
+  CHECK_EQ(11 + 13 + 64, product.e());
+
+  // Test rounding.
+  diy_fp1 = DiyFp(V8_2PART_UINT64_C(0x80000000, 00000001), 11);
+  diy_fp2 = DiyFp(1, 13);
+  product = DiyFp::Times(diy_fp1, diy_fp2);
+  CHECK(1 == product.f());  // NOLINT
+
+  diy_fp1 = DiyFp(V8_2PART_UINT64_C(0xFFFFFFFF, FFFFFFFF), 11);
+  diy_fp2 = DiyFp(V8_2PART_UINT64_C(0xFFFFFFFF, FFFFFFFF), 13);
+  product = DiyFp::Times(diy_fp1, diy_fp2);
+  CHECK(V8_2PART_UINT64_C(0xFFFFFFFF, FFFFFFFe) == product.f());
+  CHECK_EQ(11 + 13 + 64, product.e());
+}
+
+
+TEST(DoubleBoundaries) {
+  DiyFp boundary_minus;
+  DiyFp boundary_plus;
+  Double(1.5).NormalizedBoundaries(&boundary_minus, &boundary_plus);
+  CHECK_EQ(boundary_plus.e(), boundary_minus.e());
+  // 1.5 does not have a significand of the form 2^p (for some p).
+  // Therefore its boundaries are at the same distance.
+  CHECK(boundary_plus.f() - Double(1.5).AsNormalizedDiyFp().f() ==
+        Double(1.5).AsNormalizedDiyFp().f() - boundary_minus.f());
+
+  Double(1.0).NormalizedBoundaries(&boundary_minus, &boundary_plus);
+  CHECK_EQ(boundary_plus.e(), boundary_minus.e());
+  // 1.0 does have a significand of the form 2^p, so its lower boundary is
+  // closer than its upper one.
+  CHECK(2 * (Double(1.0).AsNormalizedDiyFp().f() - boundary_minus.f()) ==
+        boundary_plus.f() - Double(1.0).AsNormalizedDiyFp().f());
+}
+
+
+TEST(FastDtoaVariousDoubles) {
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  int length;
+  int point;
+  bool status;
+
+  double min_double = 5e-324;
+  status = FastDtoa(min_double, FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("5", buffer.start());
+  CHECK_EQ(-323, point);
+
+  double max_double = 1.7976931348623157e308;
+  status = FastDtoa(max_double, FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("17976931348623157", buffer.start());
+  CHECK_EQ(309, point);
+
+  status = FastDtoa(4294967272.0, FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("4294967272", buffer.start());
+  CHECK_EQ(10, point);
+
+  status = FastDtoa(0.1, FAST_DTOA_SHORTEST, 0, buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("1", buffer.start());
+  CHECK_EQ(0, point);
+
+  status = FastDtoa(0.3, FAST_DTOA_SHORTEST, 0, buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("3", buffer.start());
+  CHECK_EQ(0, point);
+
+  status = FastDtoa(4.1855804968213567e298, FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  if (status) {  // Not all numbers can be computed by Grisu3.
+    CHECK_EQ("4185580496821357", buffer.start());
+    CHECK_EQ(299, point);
+  }
+
+  status = FastDtoa(5.5626846462680035e-309, FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("5562684646268003", buffer.start());
+  CHECK_EQ(-308, point);
+
+  status = FastDtoa(2147483648.0, FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("2147483648", buffer.start());
+  CHECK_EQ(10, point);
+
+  status = FastDtoa(3.5844466002796428e+298, FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  if (status) {  // Not all numbers can be computed by Grisu3.
+    CHECK_EQ("35844466002796428", buffer.start());
+    CHECK_EQ(299, point);
+  }
+
+  uint64_t smallest_normal64 = V8_2PART_UINT64_C(0x00100000, 00000000);
+  status = FastDtoa(Double(smallest_normal64).value(), FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("22250738585072014", buffer.start());
+  CHECK_EQ(-307, point);
+
+  uint64_t largest_denormal64 = V8_2PART_UINT64_C(0x000FFFFF, FFFFFFFF);
+  status = FastDtoa(Double(largest_denormal64).value(), FAST_DTOA_SHORTEST, 0,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("2225073858507201", buffer.start());
+  CHECK_EQ(-307, point);
+}
+
+
+TEST(FastDtoaPrecisionVariousDoubles) {
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  int length;
+  int point;
+  bool status;
+
+  status = FastDtoa(1.0, FAST_DTOA_PRECISION, 3, buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ(3, length);
+  CHECK_EQ("100", buffer.start());
+  CHECK_EQ(1, point);
+
+  status = FastDtoa(1.5, FAST_DTOA_PRECISION, 10, buffer, &length, &point);
+  if (status) {
+    CHECK_EQ(10, length);
+    CHECK_EQ("1500000000", buffer.start());
+    CHECK_EQ(1, point);
+  }
+
+  double min_double = 5e-324;
+  status = FastDtoa(min_double, FAST_DTOA_PRECISION, 5,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("49407", buffer.start());
+  CHECK_EQ(-323, point);
+
+  double max_double = 1.7976931348623157e308;
+  status = FastDtoa(max_double, FAST_DTOA_PRECISION, 7,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("1797693", buffer.start());
+  CHECK_EQ(309, point);
+
+  status = FastDtoa(4294967272.0, FAST_DTOA_PRECISION, 14,
+                    buffer, &length, &point);
+  if (status) {
+    CHECK_EQ(14, length);
+    CHECK_EQ("42949672720000", buffer.start());
+    CHECK_EQ(10, point);
+  }
+
+  // Rounding that carries into a new leading digit.
+  status = FastDtoa(0.99999999, FAST_DTOA_PRECISION, 3,
+                    buffer, &length, &point);
+  CHECK(status);
+  CHECK_EQ("100", buffer.start());
+  CHECK_EQ(1, point);
+
+  // Exact halfway cases are left to dtoa.
+  status = FastDtoa(2.5, FAST_DTOA_PRECISION, 1, buffer, &length, &point);
+  CHECK(!status);
+}
+
+
+TEST(FastDtoaShortestRandomAgainstDtoa) {
+  static const int kIterations = 100000;
+  int succeeded = 0;
+  for (int i = 0; i < kIterations; i++) {
+    if (CheckAgainstDtoa(RandomFiniteDouble(), FAST_DTOA_SHORTEST, 0)) {
+      succeeded++;
+    }
+  }
+  // Grisu3 is expected to handle about 99.5% of the inputs.
+  CHECK_GT(succeeded * 100, kIterations * 99);
+}
+
+
+TEST(FastDtoaShortestNumbersAgainstDtoa) {
+  // Short decimal numbers of the kind that are common in real data.
+  int succeeded = 0;
+  int total = 0;
+  for (int i = 1; i < 100000; i += 7) {
+    for (int scale = 0; scale < 8; scale++) {
+      double v = static_cast<double>(i);
+      for (int j = 0; j < scale; j++) v /= 10;
+      total++;
+      if (CheckAgainstDtoa(v, FAST_DTOA_SHORTEST, 0)) succeeded++;
+    }
+  }
+  CHECK_GT(succeeded * 100, total * 99);
+}
+
+
+TEST(FastDtoaPrecisionRandomAgainstDtoa) {
+  static const int kIterations = 50000;
+  int succeeded = 0;
+  for (int i = 0; i < kIterations; i++) {
+    int digits = 1 + gen() % 15;
+    if (CheckAgainstDtoa(RandomFiniteDouble(), FAST_DTOA_PRECISION, digits)) {
+      succeeded++;
+    }
+  }
+  CHECK_GT(succeeded * 100, kIterations * 99);
+}
+
+
+TEST(DoubleToCStringMatchesDtoa) {
+  char buffer_container[kBufferSize];
+  Vector<char> buffer(buffer_container, kBufferSize);
+  CHECK_EQ("0.1", DoubleToCString(0.1, buffer));
+  CHECK_EQ("-0.3", DoubleToCString(-0.3, buffer));
+  CHECK_EQ("123.456", DoubleToCString(123.456, buffer));
+  CHECK_EQ("1e+21", DoubleToCString(1e21, buffer));
+  CHECK_EQ("100000000000000000000", DoubleToCString(1e20, buffer));
+  CHECK_EQ("1.7976931348623157e+308",
+           DoubleToCString(1.7976931348623157e308, buffer));
+  CHECK_EQ("5e-324", DoubleToCString(5e-324, buffer));
+  CHECK_EQ("0.000001", DoubleToCString(0.000001, buffer));
+  CHECK_EQ("1e-7", DoubleToCString(0.0000001, buffer));
+
+  char* result = DoubleToPrecisionCString(123.456, 4);
+  CHECK_EQ("123.5", result);
+  DeleteArray(result);
+  result = DoubleToPrecisionCString(0.000123, 2);
+  CHECK_EQ("0.00012", result);
+  DeleteArray(result);
+  result = DoubleToPrecisionCString(2.5, 1);
+  CHECK_EQ("3", result);
+  DeleteArray(result);
+  result = DoubleToExponentialCString(123456, 2);
+  CHECK_EQ("1.23e+5", result);
+  DeleteArray(result);
+  result = DoubleToExponentialCString(0, -1);
+  CHECK_EQ("0e+0", result);
+  DeleteArray(result);
+}
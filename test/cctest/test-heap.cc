@@ -796,3 +796,56 @@ TEST(Iteration) {
   CHECK_EQ(objs_count, next_objs_index);
   CHECK_EQ(objs_count, ObjectsFoundInHeap(objs, objs_count));
 }
+
+
+TEST(TrimSlicedStrings) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  static const int kBufferLength = 1000;
+  char chars[kBufferLength + 1];
+  for (int i = 0; i < kBufferLength; i++) chars[i] = 'a' + i % 26;
+  chars[kBufferLength] = '\0';
+
+  Handle<FixedArray> holder = Factory::NewFixedArray(3);
+  {
+    v8::HandleScope inner_scope;
+    // A short slice of a buffer that dies.
+    Handle<String> dead = Factory::NewStringFromAscii(CStrVector(chars));
+    Handle<String> short_slice = Factory::NewStringSlice(dead, 100, 200);
+    CHECK(StringShape(*short_slice).IsSliced());
+    holder->set(0, *short_slice);
+
+    // A short slice of a buffer that stays alive.
+    Handle<String> live = Factory::NewStringFromAscii(CStrVector(chars));
+    Handle<String> live_slice = Factory::NewStringSlice(live, 100, 200);
+    CHECK(StringShape(*live_slice).IsSliced());
+    holder->set(1, *live_slice);
+    holder->set(2, *live);
+  }
+  Heap::CollectAllGarbage();
+
+  SlicedString* trimmed = SlicedString::cast(holder->get(0));
+  CHECK_EQ(100, trimmed->buffer()->length());
+  CHECK_EQ(0, trimmed->start());
+  CHECK(StringShape(trimmed->buffer()).IsSequentialAscii());
+  for (int i = 0; i < 100; i++) {
+    CHECK_EQ(chars[100 + i], trimmed->Get(i));
+  }
+
+  SlicedString* kept = SlicedString::cast(holder->get(1));
+  CHECK_EQ(holder->get(2), kept->buffer());
+  CHECK_EQ(100, kept->start());
+
+  // A slice covering most of a dead buffer keeps the buffer.
+  {
+    v8::HandleScope inner_scope;
+    Handle<String> dead = Factory::NewStringFromAscii(CStrVector(chars));
+    Handle<String> long_slice = Factory::NewStringSlice(dead, 10, 990);
+    CHECK(StringShape(*long_slice).IsSliced());
+    holder->set(0, *long_slice);
+  }
+  Heap::CollectAllGarbage();
+  CHECK_EQ(kBufferLength,
+           SlicedString::cast(holder->get(0))->buffer()->length());
+}
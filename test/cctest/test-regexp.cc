@@ -36,13 +36,15 @@
 #include "parser.h"
 #include "ast.h"
 #include "jsregexp-inl.h"
+#include "bytecodes-irregexp.h"
 #include "regexp-macro-assembler.h"
 #include "regexp-macro-assembler-irregexp.h"
 #ifdef V8_TARGET_ARCH_ARM
 #include "arm/regexp-macro-assembler-arm.h"
 #endif
 #ifdef V8_TARGET_ARCH_X64
-// No X64-implementation yet.
+#include "x64/macro-assembler-x64.h"
+#include "x64/regexp-macro-assembler-x64.h"
 #endif
 #ifdef V8_TARGET_ARCH_IA32
 #include "ia32/macro-assembler-ia32.h"
@@ -647,7 +649,8 @@ TEST(MacroAssembler) {
   Handle<String> f1_16 =
       Factory::NewStringFromTwoByte(Vector<const uc16>(str1, 6));
 
-  CHECK(IrregexpInterpreter::Match(array, f1_16, captures, 0));
+  CHECK_EQ(IrregexpInterpreter::SUCCESS,
+           IrregexpInterpreter::Match(array, f1_16, captures, 0));
   CHECK_EQ(0, captures[0]);
   CHECK_EQ(3, captures[1]);
   CHECK_EQ(1, captures[2]);
@@ -658,10 +661,66 @@ TEST(MacroAssembler) {
   Handle<String> f2_16 =
       Factory::NewStringFromTwoByte(Vector<const uc16>(str2, 6));
 
-  CHECK(!IrregexpInterpreter::Match(array, f2_16, captures, 0));
+  CHECK_EQ(IrregexpInterpreter::FAILURE,
+           IrregexpInterpreter::Match(array, f2_16, captures, 0));
   CHECK_EQ(42, captures[0]);
 }
 
+
+TEST(MacroAssemblerFusedCharacterChecks) {
+  V8::Initialize(NULL);
+  byte codes[1024];
+  RegExpMacroAssemblerIrregexp m(Vector<byte>(codes, 1024));
+  // ^a[bc];
+  Label fail, second_ok;
+  m.LoadCurrentCharacter(2, &fail);
+  m.CheckNotCharacter(';', &fail);
+  m.LoadCurrentCharacter(1, &fail, false);
+  m.CheckCharacter('b', &second_ok);
+  m.CheckNotCharacter('c', &fail);
+  m.Bind(&second_ok);
+  m.LoadCurrentCharacter(0, &fail, false);
+  m.CheckNotCharacter('a', &fail);
+  m.WriteCurrentPositionToRegister(0, 0);
+  m.WriteCurrentPositionToRegister(1, 3);
+  m.Succeed();
+
+  m.Bind(&fail);
+  m.Fail();
+
+  // Each load was fused with the character check that follows it.
+  CHECK_EQ(BC_LOAD_CHAR_CHECK_NOT_CHAR, codes[0]);
+  CHECK_EQ(BC_LOAD_CHAR_UNCHECKED_CHECK_CHAR,
+           codes[BC_LOAD_CHAR_CHECK_NOT_CHAR_LENGTH]);
+  CHECK_EQ(BC_CHECK_NOT_CHAR,
+           codes[BC_LOAD_CHAR_CHECK_NOT_CHAR_LENGTH +
+                 BC_LOAD_CHAR_UNCHECKED_CHECK_CHAR_LENGTH]);
+
+  v8::HandleScope scope;
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector("^a[bc];"));
+  Handle<ByteArray> array = Handle<ByteArray>::cast(m.GetCode(source));
+  int captures[2];
+
+  const char* matches[] = { "ab;", "ac;x" };
+  for (unsigned i = 0; i < ARRAY_SIZE(matches); i++) {
+    Handle<String> subject =
+        Factory::NewStringFromAscii(CStrVector(matches[i]));
+    CHECK_EQ(IrregexpInterpreter::SUCCESS,
+             IrregexpInterpreter::Match(array, subject, captures, 0));
+    CHECK_EQ(0, captures[0]);
+    CHECK_EQ(3, captures[1]);
+  }
+
+  const char* failures[] = { "ab", "ad;", "bb;", "ab:" };
+  for (unsigned i = 0; i < ARRAY_SIZE(failures); i++) {
+    Handle<String> subject =
+        Factory::NewStringFromAscii(CStrVector(failures[i]));
+    CHECK_EQ(IrregexpInterpreter::FAILURE,
+             IrregexpInterpreter::Match(array, subject, captures, 0));
+  }
+}
+
 #ifdef V8_TARGET_ARCH_IA32  // IA32 Native Regexp only tests.
 #ifdef V8_NATIVE_REGEXP
 
@@ -1290,6 +1349,634 @@ TEST(MacroAssemblerIA32LotsOfRegisters) {
 #endif  // V8_TARGET_ARCH_IA32
 
 
+#ifdef V8_TARGET_ARCH_X64  // X64 Native Regexp only tests.
+#ifdef V8_NATIVE_REGEXP
+
+class ContextInitializer {
+ public:
+  ContextInitializer() : env_(), scope_(), stack_guard_() {
+    env_ = v8::Context::New();
+    env_->Enter();
+  }
+  ~ContextInitializer() {
+    env_->Exit();
+    env_.Dispose();
+  }
+ private:
+  v8::Persistent<v8::Context> env_;
+  v8::HandleScope scope_;
+  v8::internal::StackGuard stack_guard_;
+};
+
+
+static RegExpMacroAssemblerX64::Result ExecuteX64(Code* code,
+                                                  String* input,
+                                                  int start_offset,
+                                                  const byte* input_start,
+                                                  const byte* input_end,
+                                                  int* captures,
+                                                  bool at_start) {
+  return RegExpMacroAssemblerX64::Execute(
+      code,
+      input,
+      start_offset,
+      input_start,
+      input_end,
+      captures,
+      at_start);
+}
+
+
+TEST(MacroAssemblerX64Success) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 4);
+
+  m.Succeed();
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector(""));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  int captures[4] = {42, 37, 87, 117};
+  Handle<String> input = Factory::NewStringFromAscii(CStrVector("foofoo"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  const byte* start_adr =
+      reinterpret_cast<const byte*>(seq_input->GetCharsAddress());
+
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + seq_input->length(),
+                 captures,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(-1, captures[0]);
+  CHECK_EQ(-1, captures[1]);
+  CHECK_EQ(-1, captures[2]);
+  CHECK_EQ(-1, captures[3]);
+}
+
+
+TEST(MacroAssemblerX64Simple) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 4);
+
+  uc16 foo_chars[3] = {'f', 'o', 'o'};
+  Vector<const uc16> foo(foo_chars, 3);
+
+  Label fail;
+  m.CheckCharacters(foo, 0, &fail, true);
+  m.WriteCurrentPositionToRegister(0, 0);
+  m.AdvanceCurrentPosition(3);
+  m.WriteCurrentPositionToRegister(1, 0);
+  m.Succeed();
+  m.Bind(&fail);
+  m.Fail();
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector("^foo"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  int captures[4] = {42, 37, 87, 117};
+  Handle<String> input = Factory::NewStringFromAscii(CStrVector("foofoo"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 captures,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(0, captures[0]);
+  CHECK_EQ(3, captures[1]);
+  CHECK_EQ(-1, captures[2]);
+  CHECK_EQ(-1, captures[3]);
+
+  input = Factory::NewStringFromAscii(CStrVector("barbarbar"));
+  seq_input = Handle<SeqAsciiString>::cast(input);
+  start_adr = seq_input->GetCharsAddress();
+
+  result = ExecuteX64(*code,
+                      *input,
+                      0,
+                      start_adr,
+                      start_adr + input->length(),
+                      captures,
+                      true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::FAILURE, result);
+}
+
+
+TEST(MacroAssemblerX64SimpleUC16) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::UC16, 4);
+
+  uc16 foo_chars[3] = {'f', 'o', 'o'};
+  Vector<const uc16> foo(foo_chars, 3);
+
+  Label fail;
+  m.CheckCharacters(foo, 0, &fail, true);
+  m.WriteCurrentPositionToRegister(0, 0);
+  m.AdvanceCurrentPosition(3);
+  m.WriteCurrentPositionToRegister(1, 0);
+  m.Succeed();
+  m.Bind(&fail);
+  m.Fail();
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector("^foo"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  int captures[4] = {42, 37, 87, 117};
+  const uc16 input_data[6] = {'f', 'o', 'o', 'f', 'o', '\xa0'};
+  Handle<String> input =
+      Factory::NewStringFromTwoByte(Vector<const uc16>(input_data, 6));
+  Handle<SeqTwoByteString> seq_input = Handle<SeqTwoByteString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 captures,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(0, captures[0]);
+  CHECK_EQ(3, captures[1]);
+  CHECK_EQ(-1, captures[2]);
+  CHECK_EQ(-1, captures[3]);
+
+  const uc16 input_data2[9] = {'b', 'a', 'r', 'b', 'a', 'r', 'b', 'a', '\xa0'};
+  input = Factory::NewStringFromTwoByte(Vector<const uc16>(input_data2, 9));
+  seq_input = Handle<SeqTwoByteString>::cast(input);
+  start_adr = seq_input->GetCharsAddress();
+
+  result = ExecuteX64(*code,
+                      *input,
+                      0,
+                      start_adr,
+                      start_adr + input->length() * 2,
+                      captures,
+                      true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::FAILURE, result);
+}
+
+
+TEST(MacroAssemblerX64Backtrack) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 0);
+
+  Label fail;
+  Label backtrack;
+  m.LoadCurrentCharacter(10, &fail);
+  m.Succeed();
+  m.Bind(&fail);
+  m.PushBacktrack(&backtrack);
+  m.LoadCurrentCharacter(10, NULL);
+  m.Succeed();
+  m.Bind(&backtrack);
+  m.Fail();
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector(".........."));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  Handle<String> input = Factory::NewStringFromAscii(CStrVector("foofoo"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 NULL,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::FAILURE, result);
+}
+
+
+TEST(MacroAssemblerX64BackReferenceASCII) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 3);
+
+  m.WriteCurrentPositionToRegister(0, 0);
+  m.AdvanceCurrentPosition(2);
+  m.WriteCurrentPositionToRegister(1, 0);
+  Label nomatch;
+  m.CheckNotBackReference(0, &nomatch);
+  m.Fail();
+  m.Bind(&nomatch);
+  m.AdvanceCurrentPosition(2);
+  Label missing_match;
+  m.CheckNotBackReference(0, &missing_match);
+  m.WriteCurrentPositionToRegister(2, 0);
+  m.Succeed();
+  m.Bind(&missing_match);
+  m.Fail();
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector("^(..)..\1"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  Handle<String> input = Factory::NewStringFromAscii(CStrVector("fooofo"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  int output[3];
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 output,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(0, output[0]);
+  CHECK_EQ(2, output[1]);
+  CHECK_EQ(6, output[2]);
+}
+
+
+TEST(MacroAssemblerX64BackReferenceUC16) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::UC16, 3);
+
+  m.WriteCurrentPositionToRegister(0, 0);
+  m.AdvanceCurrentPosition(2);
+  m.WriteCurrentPositionToRegister(1, 0);
+  Label nomatch;
+  m.CheckNotBackReference(0, &nomatch);
+  m.Fail();
+  m.Bind(&nomatch);
+  m.AdvanceCurrentPosition(2);
+  Label missing_match;
+  m.CheckNotBackReference(0, &missing_match);
+  m.WriteCurrentPositionToRegister(2, 0);
+  m.Succeed();
+  m.Bind(&missing_match);
+  m.Fail();
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector("^(..)..\1"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  const uc16 input_data[6] = {'f', 0x2028, 'o', 'o', 'f', 0x2028};
+  Handle<String> input =
+      Factory::NewStringFromTwoByte(Vector<const uc16>(input_data, 6));
+  Handle<SeqTwoByteString> seq_input = Handle<SeqTwoByteString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  int output[3];
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length() * 2,
+                 output,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(0, output[0]);
+  CHECK_EQ(2, output[1]);
+  CHECK_EQ(6, output[2]);
+}
+
+
+
+TEST(MacroAssemblerX64AtStart) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 0);
+
+  Label not_at_start, newline, fail;
+  m.CheckNotAtStart(&not_at_start);
+  // Check that prevchar = '\n' and current = 'f'.
+  m.CheckCharacter('\n', &newline);
+  m.Bind(&fail);
+  m.Fail();
+  m.Bind(&newline);
+  m.LoadCurrentCharacter(0, &fail);
+  m.CheckNotCharacter('f', &fail);
+  m.Succeed();
+
+  m.Bind(&not_at_start);
+  // Check that prevchar = 'o' and current = 'b'.
+  Label prevo;
+  m.CheckCharacter('o', &prevo);
+  m.Fail();
+  m.Bind(&prevo);
+  m.LoadCurrentCharacter(0, &fail);
+  m.CheckNotCharacter('b', &fail);
+  m.Succeed();
+
+  Handle<String> source = Factory::NewStringFromAscii(CStrVector("(^f|ob)"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  Handle<String> input = Factory::NewStringFromAscii(CStrVector("foobar"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 NULL,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+
+  result = ExecuteX64(*code,
+                      *input,
+                      3,
+                      start_adr + 3,
+                      start_adr + input->length(),
+                      NULL,
+                      false);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+}
+
+
+TEST(MacroAssemblerX64BackRefNoCase) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 4);
+
+  Label fail, succ;
+
+  m.WriteCurrentPositionToRegister(0, 0);
+  m.WriteCurrentPositionToRegister(2, 0);
+  m.AdvanceCurrentPosition(3);
+  m.WriteCurrentPositionToRegister(3, 0);
+  m.CheckNotBackReferenceIgnoreCase(2, &fail);  // Match "AbC".
+  m.CheckNotBackReferenceIgnoreCase(2, &fail);  // Match "ABC".
+  Label expected_fail;
+  m.CheckNotBackReferenceIgnoreCase(2, &expected_fail);
+  m.Bind(&fail);
+  m.Fail();
+
+  m.Bind(&expected_fail);
+  m.AdvanceCurrentPosition(3);  // Skip "xYz"
+  m.CheckNotBackReferenceIgnoreCase(2, &succ);
+  m.Fail();
+
+  m.Bind(&succ);
+  m.WriteCurrentPositionToRegister(1, 0);
+  m.Succeed();
+
+  Handle<String> source =
+      Factory::NewStringFromAscii(CStrVector("^(abc)\1\1(?!\1)...(?!\1)"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  Handle<String> input =
+      Factory::NewStringFromAscii(CStrVector("aBcAbCABCxYzab"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  int output[4];
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 output,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(0, output[0]);
+  CHECK_EQ(12, output[1]);
+  CHECK_EQ(0, output[2]);
+  CHECK_EQ(3, output[3]);
+}
+
+
+
+TEST(MacroAssemblerX64Registers) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 5);
+
+  uc16 foo_chars[3] = {'f', 'o', 'o'};
+  Vector<const uc16> foo(foo_chars, 3);
+
+  enum registers { out1, out2, out3, out4, out5, sp, loop_cnt };
+  Label fail;
+  Label backtrack;
+  m.WriteCurrentPositionToRegister(out1, 0);  // Output: [0]
+  m.PushRegister(out1, RegExpMacroAssembler::kNoStackLimitCheck);
+  m.PushBacktrack(&backtrack);
+  m.WriteStackPointerToRegister(sp);
+  // Fill stack and registers
+  m.AdvanceCurrentPosition(2);
+  m.WriteCurrentPositionToRegister(out1, 0);
+  m.PushRegister(out1, RegExpMacroAssembler::kNoStackLimitCheck);
+  m.PushBacktrack(&fail);
+  // Drop backtrack stack frames.
+  m.ReadStackPointerFromRegister(sp);
+  // And take the first backtrack (to &backtrack)
+  m.Backtrack();
+
+  m.PushCurrentPosition();
+  m.AdvanceCurrentPosition(2);
+  m.PopCurrentPosition();
+
+  m.Bind(&backtrack);
+  m.PopRegister(out1);
+  m.ReadCurrentPositionFromRegister(out1);
+  m.AdvanceCurrentPosition(3);
+  m.WriteCurrentPositionToRegister(out2, 0);  // [0,3]
+
+  Label loop;
+  m.SetRegister(loop_cnt, 0);  // loop counter
+  m.Bind(&loop);
+  m.AdvanceRegister(loop_cnt, 1);
+  m.AdvanceCurrentPosition(1);
+  m.IfRegisterLT(loop_cnt, 3, &loop);
+  m.WriteCurrentPositionToRegister(out3, 0);  // [0,3,6]
+
+  Label loop2;
+  m.SetRegister(loop_cnt, 2);  // loop counter
+  m.Bind(&loop2);
+  m.AdvanceRegister(loop_cnt, -1);
+  m.AdvanceCurrentPosition(1);
+  m.IfRegisterGE(loop_cnt, 0, &loop2);
+  m.WriteCurrentPositionToRegister(out4, 0);  // [0,3,6,9]
+
+  Label loop3;
+  Label exit_loop3;
+  m.PushRegister(out4, RegExpMacroAssembler::kNoStackLimitCheck);
+  m.PushRegister(out4, RegExpMacroAssembler::kNoStackLimitCheck);
+  m.ReadCurrentPositionFromRegister(out3);
+  m.Bind(&loop3);
+  m.AdvanceCurrentPosition(1);
+  m.CheckGreedyLoop(&exit_loop3);
+  m.GoTo(&loop3);
+  m.Bind(&exit_loop3);
+  m.PopCurrentPosition();
+  m.WriteCurrentPositionToRegister(out5, 0);  // [0,3,6,9,9]
+
+  m.Succeed();
+
+  m.Bind(&fail);
+  m.Fail();
+
+  Handle<String> source =
+      Factory::NewStringFromAscii(CStrVector("<loop test>"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  // String long enough for test (content doesn't matter).
+  Handle<String> input =
+      Factory::NewStringFromAscii(CStrVector("foofoofoofoofoo"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  int output[5];
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 output,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(0, output[0]);
+  CHECK_EQ(3, output[1]);
+  CHECK_EQ(6, output[2]);
+  CHECK_EQ(9, output[3]);
+  CHECK_EQ(9, output[4]);
+}
+
+
+TEST(MacroAssemblerX64StackOverflow) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 0);
+
+  Label loop;
+  m.Bind(&loop);
+  m.PushBacktrack(&loop);
+  m.GoTo(&loop);
+
+  Handle<String> source =
+      Factory::NewStringFromAscii(CStrVector("<stack overflow test>"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  // String long enough for test (content doesn't matter).
+  Handle<String> input =
+      Factory::NewStringFromAscii(CStrVector("dummy"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 NULL,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::EXCEPTION, result);
+  CHECK(Top::has_pending_exception());
+  Top::clear_pending_exception();
+}
+
+
+TEST(MacroAssemblerX64LotsOfRegisters) {
+  v8::V8::Initialize();
+  ContextInitializer initializer;
+
+  RegExpMacroAssemblerX64 m(RegExpMacroAssemblerX64::ASCII, 2);
+
+  // At least 2048, to ensure the allocated space for registers
+  // span one full page.
+  const int large_number = 8000;
+  m.WriteCurrentPositionToRegister(large_number, 42);
+  m.WriteCurrentPositionToRegister(0, 0);
+  m.WriteCurrentPositionToRegister(1, 1);
+  Label done;
+  m.CheckNotBackReference(0, &done);  // Performs a system-stack push.
+  m.Bind(&done);
+  m.PushRegister(large_number, RegExpMacroAssembler::kNoStackLimitCheck);
+  m.PopRegister(1);
+  m.Succeed();
+
+  Handle<String> source =
+      Factory::NewStringFromAscii(CStrVector("<huge register space test>"));
+  Handle<Object> code_object = m.GetCode(source);
+  Handle<Code> code = Handle<Code>::cast(code_object);
+
+  // String long enough for test (content doesn't matter).
+  Handle<String> input =
+      Factory::NewStringFromAscii(CStrVector("sample text"));
+  Handle<SeqAsciiString> seq_input = Handle<SeqAsciiString>::cast(input);
+  Address start_adr = seq_input->GetCharsAddress();
+
+  int captures[2];
+  RegExpMacroAssemblerX64::Result result =
+      ExecuteX64(*code,
+                 *input,
+                 0,
+                 start_adr,
+                 start_adr + input->length(),
+                 captures,
+                 true);
+
+  CHECK_EQ(RegExpMacroAssemblerX64::SUCCESS, result);
+  CHECK_EQ(0, captures[0]);
+  CHECK_EQ(42, captures[1]);
+
+  Top::clear_pending_exception();
+}
+
+#endif  // V8_REGEXP_NATIVE
+#endif  // V8_TARGET_ARCH_X64
+
+
 TEST(AddInverseToTable) {
   static const int kLimit = 1000;
   static const int kRangeCount = 16;
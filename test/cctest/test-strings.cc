@@ -12,6 +12,7 @@
 #include "api.h"
 #include "factory.h"
 #include "cctest.h"
+#include "runtime.h"
 #include "zone-inl.h"
 
 unsigned int seed = 123;
@@ -73,12 +74,12 @@ static void InitializeBuildingBlocks(
       case 1: {
         char buf[2000];
         for (int j = 0; j < len; j++) {
-          buf[j] = gen() % 128;
+          buf[j] = gen() % 256;
         }
         building_blocks[i] =
             Factory::NewStringFromAscii(Vector<const char>(buf, len));
         for (int j = 0; j < len; j++) {
-          CHECK_EQ(buf[j], building_blocks[i]->Get(j));
+          CHECK_EQ(static_cast<byte>(buf[j]), building_blocks[i]->Get(j));
         }
         break;
       }
@@ -110,12 +111,12 @@ static void InitializeBuildingBlocks(
       case 3: {
         char* buf = NewArray<char>(len);
         for (int j = 0; j < len; j++) {
-          buf[j] = gen() % 128;
+          buf[j] = gen() % 256;
         }
         building_blocks[i] =
             Factory::NewStringFromAscii(Vector<const char>(buf, len));
         for (int j = 0; j < len; j++) {
-          CHECK_EQ(buf[j], building_blocks[i]->Get(j));
+          CHECK_EQ(static_cast<byte>(buf[j]), building_blocks[i]->Get(j));
         }
         DeleteArray<char>(buf);
         break;
@@ -514,3 +515,102 @@ TEST(Regress9746) {
   delete[] source;
   delete[] key;
 }
+
+
+TEST(Latin1Representation) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  // Latin-1 text is stored one byte per character.
+  Handle<String> cafe = Factory::NewStringFromUtf8(CStrVector("caf\xc3\xa9"));
+  CHECK_EQ(4, cafe->length());
+  CHECK(cafe->IsAsciiRepresentation());
+  CHECK_EQ(0xe9, cafe->Get(3));
+  const uc16 cafe_two_byte_chars[] = { 'c', 'a', 'f', 0xe9 };
+  Handle<String> cafe_two_byte =
+      Factory::NewStringFromTwoByte(Vector<const uc16>(cafe_two_byte_chars, 4));
+  CHECK(cafe_two_byte->IsAsciiRepresentation());
+  CHECK(cafe->Equals(*cafe_two_byte));
+
+  // Anything beyond Latin-1 still needs two bytes.
+  Handle<String> euro = Factory::NewStringFromUtf8(CStrVector("\xe2\x82\xac"));
+  CHECK_EQ(1, euro->length());
+  CHECK(euro->IsTwoByteRepresentation());
+
+  // Symbols and the single character cache.
+  Handle<String> symbol = Factory::LookupSymbol(CStrVector("caf\xc3\xa9"));
+  CHECK(symbol->IsAsciiRepresentation());
+  CHECK(symbol->Equals(*cafe));
+  Object* e_acute = Heap::LookupSingleCharacterStringFromCode(0xe9);
+  CHECK(String::cast(e_acute)->IsAsciiRepresentation());
+  CHECK_EQ(0xe9, String::cast(e_acute)->Get(0));
+  CHECK_EQ(e_acute, Heap::LookupSingleCharacterStringFromCode(0xe9));
+}
+
+
+TEST(Latin1MixedEncodingConcatAndCompare) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  Handle<String> latin1 =
+      Factory::NewStringFromUtf8(CStrVector("\xc3\xa9t\xc3\xa9 "));
+  Handle<String> ascii = Factory::NewStringFromAscii(CStrVector("abc"));
+  const uc16 two_byte_chars[] = { 0xe9, 't', 0xe9, ' ', 0x100 };
+  Handle<String> two_byte =
+      Factory::NewStringFromTwoByte(Vector<const uc16>(two_byte_chars, 5));
+  CHECK(latin1->IsAsciiRepresentation());
+  CHECK(two_byte->IsTwoByteRepresentation());
+
+  // Concatenating one-byte strings stays one-byte.
+  Handle<String> cons = Factory::NewConsString(latin1, ascii);
+  CHECK(cons->IsAsciiRepresentation());
+  FlattenString(cons);
+  CHECK(cons->IsAsciiRepresentation());
+  CHECK_EQ(7, cons->length());
+  CHECK_EQ(0xe9, cons->Get(2));
+
+  // Mixing in a two-byte string does not.
+  Handle<String> mixed = Factory::NewConsString(latin1, two_byte);
+  CHECK(mixed->IsTwoByteRepresentation());
+  CHECK_EQ(0xe9, mixed->Get(4));
+  CHECK_EQ(0x100, mixed->Get(8));
+
+  // The same characters compare equal whatever their representation.
+  Handle<String> prefix = Factory::NewStringSlice(two_byte, 0, 4);
+  CHECK(prefix->IsTwoByteRepresentation());
+  CHECK(latin1->Equals(*prefix));
+  CHECK(prefix->Equals(*latin1));
+  CHECK(!latin1->Equals(*Factory::NewStringSlice(two_byte, 1, 5)));
+  CHECK_EQ(0, Runtime::StringMatch(two_byte, latin1, 0));
+  CHECK_EQ(2, Runtime::StringMatch(cons, Factory::NewStringSlice(two_byte,
+                                                                  2,
+                                                                  4), 0));
+
+  // Reading the string through the character stream decodes Latin-1.
+  StringInputBuffer input(*mixed);
+  for (int i = 0; i < mixed->length(); i++) {
+    CHECK(input.has_more());
+    CHECK_EQ(mixed->Get(i), input.GetNext());
+  }
+  CHECK(!input.has_more());
+}
+
+
+TEST(Latin1Utf8Conversion) {
+  InitializeVM();
+  v8::HandleScope handle_scope;
+  // U+00E9 -> C3 A9, U+00FF -> C3 BF
+  const char* utf8 = "a\xc3\xa9z\xc3\xbf";
+  v8::Handle<v8::String> string = v8::String::New(utf8);
+  CHECK_EQ(4, string->Length());
+  CHECK(v8::Utils::OpenHandle(*string)->IsAsciiRepresentation());
+  CHECK_EQ(6, string->Utf8Length());
+  char buffer[7];
+  CHECK_EQ(7, string->WriteUtf8(buffer));
+  CHECK_EQ(0, strcmp(utf8, buffer));
+  v8::String::Utf8Value value(string);
+  CHECK_EQ(0, strcmp(utf8, *value));
+  // WriteAscii writes the low byte of each character.
+  CHECK_EQ(4, string->WriteAscii(buffer));
+  CHECK_EQ(0, strcmp("a\xe9z\xff", buffer));
+}
@@ -0,0 +1,185 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "cctest.h"
+#include "double.h"
+#include "platform.h"
+#include "strtod.h"
+
+using namespace v8::internal;
+
+
+extern "C" double gay_strtod(const char* s00, const char** se);
+
+
+static Vector<const char> StringToVector(const char* str) {
+  return Vector<const char>(str, strlen(str));
+}
+
+
+static double StrtodChar(const char* str, int exponent) {
+  return Strtod(StringToVector(str), exponent);
+}
+
+
+// Deterministic random bit source for the randomized comparisons below.
+static uint32_t seed = 0x31415926;
+
+static uint32_t gen() {
+  seed = seed * 1103515245 + 12345;
+  uint32_t high = seed >> 16;
+  seed = seed * 1103515245 + 12345;
+  return (high << 16) | (seed >> 16);
+}
+
+
+TEST(Strtod) {
+  CHECK_EQ(0.0, StrtodChar("0", 1));
+  CHECK_EQ(0.0, StrtodChar("0", 0));
+  CHECK_EQ(0.0, StrtodChar("000000000", 300));
+
+  CHECK_EQ(1.0, StrtodChar("1", 0));
+  CHECK_EQ(2.0, StrtodChar("2", 0));
+  CHECK_EQ(10.0, StrtodChar("1", 1));
+  CHECK_EQ(1e20, StrtodChar("1", 20));
+  CHECK_EQ(1e22, StrtodChar("1", 22));
+  CHECK_EQ(1e23, StrtodChar("1", 23));
+  CHECK_EQ(1e35, StrtodChar("1", 35));
+  CHECK_EQ(1e36, StrtodChar("1", 36));
+  CHECK_EQ(1e37, StrtodChar("1", 37));
+  CHECK_EQ(1e-1, StrtodChar("1", -1));
+  CHECK_EQ(1e-2, StrtodChar("1", -2));
+  CHECK_EQ(1e-5, StrtodChar("1", -5));
+  CHECK_EQ(1e-20, StrtodChar("1", -20));
+  CHECK_EQ(1e-22, StrtodChar("1", -22));
+  CHECK_EQ(1e-23, StrtodChar("1", -23));
+  CHECK_EQ(1e-25, StrtodChar("1", -25));
+  CHECK_EQ(1e-39, StrtodChar("1", -39));
+
+  CHECK_EQ(123456789.0, StrtodChar("123456789", 0));
+  CHECK_EQ(1234567890.0, StrtodChar("123456789", 1));
+  CHECK_EQ(1.23456789e25, StrtodChar("123456789", 17));
+  CHECK_EQ(1.23456789e-10, StrtodChar("123456789", -18));
+  CHECK_EQ(1.23456789e-65, StrtodChar("123456789", -73));
+
+  CHECK_EQ(0.1, StrtodChar("1", -1));
+  CHECK_EQ(0.3, StrtodChar("3", -1));
+  CHECK_EQ(0.30000000000000004, StrtodChar("30000000000000004", -17));
+
+  CHECK_EQ(V8_INFINITY, StrtodChar("1", 309));
+  CHECK_EQ(1e308, StrtodChar("1", 308));
+  CHECK_EQ(1.7976931348623157e308, StrtodChar("17976931348623157", 292));
+  CHECK_EQ(1.7976931348623157e308, StrtodChar("17976931348623158", 292));
+  CHECK_EQ(V8_INFINITY, StrtodChar("17976931348623159", 292));
+
+  CHECK_EQ(0.0, StrtodChar("1", -325));
+  CHECK_EQ(0.0, StrtodChar("24703282292062327", -340));
+  CHECK_EQ(5e-324, StrtodChar("24703282292062328", -340));
+  CHECK_EQ(5e-324, StrtodChar("4", -324));
+  CHECK_EQ(5e-324, StrtodChar("49406564584124654", -340));
+  CHECK_EQ(2.2250738585072014e-308, StrtodChar("22250738585072014", -324));
+  CHECK_EQ(2.225073858507201e-308, StrtodChar("2225073858507201", -323));
+
+  // Halfway cases round to even.
+  CHECK_EQ(9007199254740992.0, StrtodChar("9007199254740993", 0));
+  CHECK_EQ(9007199254740996.0, StrtodChar("9007199254740995", 0));
+  CHECK_EQ(9007199254740992.0, StrtodChar("90071992547409930", -1));
+  // But anything above a halfway case rounds up.
+  CHECK_EQ(9007199254740994.0,
+           StrtodChar("900719925474099300000000000000000000001", -23));
+
+  // Trailing zeros are ignored.
+  CHECK_EQ(1.0, StrtodChar("1000", -3));
+  CHECK_EQ(1e300, StrtodChar("1000000000000000000000000000000", 270));
+}
+
+
+TEST(StrtodLongInput) {
+  // More digits than Strtod looks at: a 1 after the limit still has to
+  // influence rounding of an exact halfway case.
+  static const int kLength = 1000;
+  char buffer[kLength + 1];
+  const char* prefix = "9007199254740993";
+  int prefix_length = strlen(prefix);
+  memcpy(buffer, prefix, prefix_length);
+  for (int i = prefix_length; i < kLength; i++) buffer[i] = '0';
+  buffer[kLength] = '\0';
+  int exponent = -(kLength - prefix_length);
+  CHECK_EQ(9007199254740992.0, StrtodChar(buffer, exponent));
+  buffer[kLength - 1] = '1';
+  CHECK_EQ(9007199254740994.0, StrtodChar(buffer, exponent));
+}
+
+
+TEST(StrtodRandomAgainstGayStrtod) {
+  static const int kIterations = 100000;
+  char buffer[64];
+  char digits[32];
+  for (int i = 0; i < kIterations; i++) {
+    // Random digit strings of up to 25 digits with exponents that cover
+    // the fast path, the extended precision path and the bignum fallback.
+    int length = 1 + gen() % 25;
+    digits[0] = '1' + gen() % 9;
+    for (int j = 1; j < length; j++) digits[j] = '0' + gen() % 10;
+    digits[length] = '\0';
+    int exponent = static_cast<int>(gen() % 700) - 350;
+    OS::SNPrintF(Vector<char>(buffer, ARRAY_SIZE(buffer)),
+                 "%se%d", digits, exponent);
+    const char* end;
+    double expected = gay_strtod(buffer, &end);
+    CHECK_EQ(expected, StrtodChar(digits, exponent));
+  }
+}
+
+
+TEST(StrtodRandomDoublesRoundTrip) {
+  static const int kIterations = 100000;
+  char buffer[64];
+  for (int i = 0; i < kIterations; i++) {
+    uint64_t bits = (static_cast<uint64_t>(gen()) << 32) | gen();
+    Double d(bits & ~Double::kSignMask);
+    if (d.IsSpecial()) continue;
+    // 17 significant digits always identify a double uniquely.
+    OS::SNPrintF(Vector<char>(buffer, ARRAY_SIZE(buffer)),
+                 "%.16e", d.value());
+    CHECK_EQ(d.value(), StringToDouble(buffer, NO_FLAGS));
+  }
+}
+
+
+TEST(StringToDoubleDecimalSyntax) {
+  CHECK_EQ(0.5, StringToDouble(".5", NO_FLAGS));
+  CHECK_EQ(5.0, StringToDouble("5.", NO_FLAGS));
+  CHECK_EQ(0.5, StringToDouble("+.5", NO_FLAGS));
+  CHECK_EQ(-0.005, StringToDouble("-.5e-2", NO_FLAGS));
+  CHECK_EQ(0.0001, StringToDouble("0.1e-0003", NO_FLAGS));
+  CHECK_EQ(100000.0, StringToDouble("1E5", NO_FLAGS));
+  CHECK_EQ(100000.0, StringToDouble("1e+5", NO_FLAGS));
+  CHECK_EQ(0.5, StringToDouble("00.5", NO_FLAGS));
+  CHECK_EQ(V8_INFINITY, StringToDouble("1e1000", NO_FLAGS));
+  CHECK_EQ(V8_INFINITY, StringToDouble("1e99999999999", NO_FLAGS));
+  CHECK_EQ(0.0, StringToDouble("1e-1000", NO_FLAGS));
+  CHECK_EQ(-V8_INFINITY, StringToDouble("-Infinity", NO_FLAGS));
+  CHECK_EQ(V8_INFINITY, StringToDouble("+Infinity", NO_FLAGS));
+
+  CHECK(isnan(StringToDouble(".", NO_FLAGS)));
+  CHECK(isnan(StringToDouble(".e1", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("1e", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("1e+", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("1..", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("-", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("+", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("-+1", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("--1", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("infinity", NO_FLAGS)));
+  CHECK(isnan(StringToDouble("Infinit", NO_FLAGS)));
+
+  CHECK_EQ(1.0, StringToDouble("1e", ALLOW_TRAILING_JUNK));
+  CHECK_EQ(1.0, StringToDouble("1e+", ALLOW_TRAILING_JUNK));
+  CHECK_EQ(5000.0, StringToDouble("5e+3x", ALLOW_TRAILING_JUNK));
+  CHECK_EQ(100000.0, StringToDouble("1e5.5", ALLOW_TRAILING_JUNK));
+  CHECK_EQ(V8_INFINITY, StringToDouble("Infinityx", ALLOW_TRAILING_JUNK));
+}
@@ -0,0 +1,123 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test inline caches that have seen a few receiver maps.
+
+function load(o) {
+  return o.x;
+}
+
+function call(o) {
+  return o.f();
+}
+
+function Shape(n) {
+  // Give each shape its own map by adding properties in a different
+  // order.
+  for (var i = 0; i < n; i++) this["p" + i] = i;
+  this.x = n;
+  this.f = function() { return this.x; };
+}
+
+function Proto() { }
+Proto.prototype.x = "proto";
+Proto.prototype.f = function() { return "proto f"; };
+
+var shapes = [];
+for (var i = 0; i < 8; i++) shapes.push(new Shape(i));
+var proto = new Proto();
+
+// Two to four maps.
+for (var n = 2; n <= 4; n++) {
+  for (var j = 0; j < 10; j++) {
+    for (var i = 0; i < n; i++) {
+      assertEquals(i, load(shapes[i]));
+      assertEquals(i, call(shapes[i]));
+    }
+  }
+}
+
+// A load from the prototype mixed with own properties.
+for (var j = 0; j < 10; j++) {
+  assertEquals(0, load(shapes[0]));
+  assertEquals("proto", load(proto));
+  assertEquals(0, call(shapes[0]));
+  assertEquals("proto f", call(proto));
+}
+
+// More maps than a polymorphic cache handles.
+for (var j = 0; j < 10; j++) {
+  for (var i = 0; i < shapes.length; i++) {
+    assertEquals(i, load(shapes[i]));
+    assertEquals(i, call(shapes[i]));
+  }
+  assertEquals("proto", load(proto));
+}
+
+// Changes to the prototype are noticed by the cached handlers.
+function loadFresh(o) {
+  return o.x;
+}
+
+function callFresh(o) {
+  return o.f();
+}
+
+for (var j = 0; j < 10; j++) {
+  assertEquals(1, loadFresh(shapes[1]));
+  assertEquals("proto", loadFresh(proto));
+  assertEquals(1, callFresh(shapes[1]));
+  assertEquals("proto f", callFresh(proto));
+}
+Proto.prototype.x = "changed";
+Proto.prototype.f = function() { return "changed f"; };
+for (var j = 0; j < 10; j++) {
+  assertEquals(1, loadFresh(shapes[1]));
+  assertEquals("changed", loadFresh(proto));
+  assertEquals(1, callFresh(shapes[1]));
+  assertEquals("changed f", callFresh(proto));
+}
+proto.x = "own";
+proto.f = function() { return "own f"; };
+for (var j = 0; j < 10; j++) {
+  assertEquals("own", loadFresh(proto));
+  assertEquals("own f", callFresh(proto));
+  assertEquals(1, loadFresh(shapes[1]));
+  assertEquals(1, callFresh(shapes[1]));
+}
+
+// Values and smis reaching a polymorphic call site.
+function callToString(o) {
+  return o.toString();
+}
+
+for (var j = 0; j < 10; j++) {
+  assertEquals("[object Object]", callToString({}));
+  assertEquals("[object Object]", callToString({a: 1}));
+  assertEquals("str", callToString("str"));
+  assertEquals("1", callToString(1));
+}
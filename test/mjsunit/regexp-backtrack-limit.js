@@ -0,0 +1,61 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --regexp-backtrack-limit=100000
+
+// Matches that backtrack too much throw a RangeError instead of running
+// for exponential time.
+
+function CheckTooComplex(re, subject) {
+  var caught = false;
+  try {
+    re.exec(subject);
+  } catch (e) {
+    assertTrue(e instanceof RangeError, "RangeError for " + re);
+    caught = true;
+  }
+  assertTrue(caught, "Exception for " + re);
+}
+
+var as = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+CheckTooComplex(/(a+)+b/, as);
+CheckTooComplex(/(a|aa)+$/, as + "!");
+CheckTooComplex(/^(a|a)*$/, as + "!");
+CheckTooComplex(/(a|a)*!$/g, as + "!x");
+assertThrows("(as + '!').replace(/(a|aa)+$/g, 'x')");
+assertThrows("(as + '!x').split(/(a|a)*!$/)");
+
+// The regexp is still usable after the exception.
+var re = /(a+)+b/;
+CheckTooComplex(re, as);
+assertEquals("aab", re.exec("xaab")[0]);
+assertTrue(re.test(as + "b"));
+
+// Matches within the limit are unaffected, even if they backtrack.
+assertEquals("aaaaaaaaaab", /(a+)+b/.exec("aaaaaaaaaab")[0]);
+assertNull(/(a+)+b/.exec("aaaaaaaaaa"));
+assertEquals(1000, "x".replace(/x/, new Array(1001).join("y")).length);
@@ -0,0 +1,70 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Case independent atoms are checked several characters at a time with a
+// mask and compare, and case independent back references take a shortcut
+// for ASCII characters.  Check both against one-byte and two-byte subjects.
+
+var twoByte = "\u1234";
+
+function test(re, subject, expected) {
+  var m = re.exec(subject);
+  assertEquals(expected, m && m[0], re + " " + subject);
+  m = re.exec(subject + twoByte);
+  assertEquals(expected, m && m[0], re + " " + subject + " (two byte)");
+}
+
+test(/keyword/i, "xx KeYwOrD yy", "KeYwOrD");
+test(/keyword/i, "xx KeYwOrX keyword", "keyword");
+test(/ke[y]word/i, "xKEYWORDx", "KEYWORD");
+test(/abcdefgh/i, "ABCDEFGH", "ABCDEFGH");
+test(/abcdefgh/i, "ABCDEFG", null);
+test(/abcdefgh/i, "ABCDEFGI", null);
+test(/x\u00e0\u00e9\u00ee\u00f5\u00fc/i,
+     "X\u00c0\u00c9\u00ce\u00d5\u00dc",
+     "X\u00c0\u00c9\u00ce\u00d5\u00dc");
+test(/\u00ff\u00ff\u00ff\u00ff\u00ff/i, "\u0178\u0178\u0178\u0178\u0178",
+     "\u0178\u0178\u0178\u0178\u0178");
+test(/\u0178\u0178\u0178\u0178\u0178/i, "\u00ff\u00ff\u00ff\u00ff\u00ff",
+     "\u00ff\u00ff\u00ff\u00ff\u00ff");
+test(/abcdefgh\u1234/i, "ABCDEFGH\u1234", "ABCDEFGH\u1234");
+
+// Characters that differ from a letter only in the case bit must not match.
+test(/@@@@@@@@/i, "````````", null);
+test(/\[\[\[\[\[\[\[\[/i, "{{{{{{{{", null);
+test(/k@y_word/i, "K`Y_WORD", null);
+test(/k@y_word/i, "K@Y_WORD", "K@Y_WORD");
+test(/k@y_word/i, "K@Y\x7fWORD", null);
+
+test(/(abcdef)=\1/i, "abcdef=ABCDEF", "abcdef=ABCDEF");
+test(/(abcdef)=\1/i, "xbcdef=ABCDEF abcdef=aBcDeF", "abcdef=aBcDeF");
+test(/(ab@def)=\1/i, "ab@def=AB`DEF", null);
+test(/(\w+)=\1/i, "Abcdef=aBCDEg ABCDEF=abcdef", "ABCDEF=abcdef");
+test(/(s)\1/i, "s\u017f", null);
+test(/(\u00b5)\1/i, "\u00b5\u039c", "\u00b5\u039c");
+test(/(a\u1234)\1/i, "a\u1234A\u1234", "a\u1234A\u1234");
+test(/(a\u00e0)\1/i, "a\u00e0A\u00c0", "a\u00e0A\u00c0");
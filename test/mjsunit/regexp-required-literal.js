@@ -0,0 +1,84 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Regexps containing a literal that every match must contain are
+// prefiltered by searching the subject for the literal.  These tests
+// check that the prefilter never rejects or skips past a real match.
+
+function CheckExec(re, str, index, match) {
+  var result = re.exec(str);
+  if (index < 0) {
+    assertNull(result, re + " on " + str);
+  } else {
+    assertEquals(index, result.index, re + " on " + str);
+    assertEquals(match, result.join("|"), re + " on " + str);
+  }
+}
+
+// Literal at a fixed offset from the start of the match.
+CheckExec(/ERROR: (\w+)/, "blah blah ERROR: disk full", 10, "ERROR: disk|disk");
+CheckExec(/ERROR: (\w+)/, "blah blah ERRO", -1);
+CheckExec(/\d\d-abc/, "x1-abc 12-abc", 7, "12-abc");
+CheckExec(/[a-z]{2}xy/, "xy axy abxy", 7, "abxy");
+CheckExec(/(?:ab)+c/, "ababx ababc", 6, "ababc");
+CheckExec(/(?=abc)ab/, "aab abc", 4, "ab");
+
+// Literal at a variable offset.
+CheckExec(/\w+@example\.com/, "mail bob@example.com now", 5, "bob@example.com");
+CheckExec(/(a+)bc/, "aaaaxbc aabc", 8, "aabc|aa");
+CheckExec(/x*foo/, "fofoo", 2, "foo");
+CheckExec(/a{0,3}bcd/, "aaaaabcd", 2, "aaabcd");
+CheckExec(/(\d+)ms\nERROR/, "1ms\nINFO 22ms\nERROR", 9, "22ms\nERROR|22");
+CheckExec(/(\d+)ms\nERROR/, "1ms\nINFO 22ms\nINFO", -1);
+
+// Literals that are not required must not be used.
+CheckExec(/a|b/, "ccb", 2, "b");
+CheckExec(/(?:foo)?bar/, "bar", 0, "bar");
+CheckExec(/x(?:abc)*y/, "xy", 0, "xy");
+CheckExec(/\bfoo/, "afoo foo", 5, "foo");
+CheckExec(/^foo/m, "bar\nfoo", 4, "foo");
+CheckExec(/FOO/i, "xfoo", 1, "foo");
+CheckExec(/a.b/, "ab axb", 3, "axb");
+CheckExec(/aሴb/, "aaሴb", 1, "aሴb");
+
+// The search has to respect lastIndex for global regexps.
+var re = /a(b)c/g;
+re.lastIndex = 3;
+CheckExec(re, "abcxabc", 4, "abc|b");
+assertEquals(7, re.lastIndex);
+CheckExec(re, "abcxabc", -1);
+assertEquals(0, re.lastIndex);
+assertEquals("f0o b0o z0o", "foo boo zoo".replace(/o(\w)/g, "0$1"));
+assertEquals("oo,oo,oo", String("foo boo zoo".match(/oo/g)));
+
+// Subjects long enough for the string search to switch to Boyer-Moore.
+var s = "";
+for (var i = 0; i < 1000; i++) s += "INFO: request " + i + " served\n";
+CheckExec(/user=(\w+)/, s, -1);
+CheckExec(/(\d+) served\nERROR/, s + "ERROR", s.lastIndexOf("999"),
+          "999 served\nERROR|999");
+CheckExec(/ERROR: (\w+)/, s + "ERROR: x", s.length, "ERROR: x|x");
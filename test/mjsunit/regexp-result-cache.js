@@ -0,0 +1,102 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --expose-gc
+
+// Repeated matches of the same regexp against the same subject from the
+// same index are answered from a cache.  The results and the static
+// RegExp properties must be the same as without it.
+
+var subject = "key1=value1;key2=value2;key3=value3";
+var re = /(\w+)=(\w+)/;
+
+for (var i = 0; i < 3; i++) {
+  var m = re.exec(subject);
+  assertEquals(["key1=value1", "key1", "value1"], m);
+  assertEquals(0, m.index);
+  assertEquals(subject, m.input);
+  assertEquals("key1", RegExp.$1);
+  assertEquals("value1", RegExp.$2);
+  // Modifying a result must not affect later ones.
+  m[1] = "changed";
+  m.push("extra");
+
+  // Another match in between changes the static properties.
+  assertEquals(["a=b", "a", "b"], re.exec("a=b"));
+  assertEquals("a", RegExp.$1);
+  assertTrue(/z(z)/.test("zz"));
+  assertEquals("z", RegExp.$1);
+  if (i == 1) gc();
+}
+
+// Failed matches are cached too.
+for (var i = 0; i < 3; i++) {
+  assertNull(/x(y)/.exec(subject));
+  assertEquals("z", RegExp.$1);
+}
+
+// Global regexps start from lastIndex, which is part of the key.
+var global = /(\w+)=/g;
+for (var i = 0; i < 3; i++) {
+  global.lastIndex = 0;
+  var keys = [];
+  var m;
+  while ((m = global.exec(subject)) != null) keys.push(m[1]);
+  assertEquals(["key1", "key2", "key3"], keys);
+  assertEquals(0, global.lastIndex);
+}
+
+// Splitting the same subject repeatedly.
+for (var i = 0; i < 3; i++) {
+  assertEquals(["key1", "value1", "key2", "value2", "key3", "value3"],
+               subject.split(/[=;]/));
+  assertEquals(["key1", "=", "value1", ";", "key2"],
+               subject.split(/([=;])/, 5));
+  if (i == 1) gc();
+}
+
+// The same pattern in a different regexp object, and different subjects
+// with the same contents.
+var contents = "abc abc";
+for (var i = 0; i < 3; i++) {
+  var m = new RegExp("(b)c", "g").exec(contents);
+  assertEquals(1, m.index);
+  var other = "x" + contents;
+  m = /(b)c/.exec(other.substring(1));
+  assertEquals(1, m.index);
+  m = /(b)c/.exec(other);
+  assertEquals(2, m.index);
+}
+
+// Patterns with many captures are not cached but still work.
+var many = /(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)/;
+for (var i = 0; i < 3; i++) {
+  var m = many.exec("xabcdefghijk");
+  assertEquals(12, m.length);
+  assertEquals("k", m[11]);
+  assertEquals("a", RegExp.$1);
+}
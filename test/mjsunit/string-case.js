@@ -26,3 +26,54 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 assertEquals("ΚΟΣΜΟΣ ΚΟΣΜΟΣ".toLowerCase(), "κοσμος κοσμος");
+
+// Reference conversions working one character at a time.
+function simpleLower(s) {
+  var result = "";
+  for (var i = 0; i < s.length; i++) {
+    var c = s.charCodeAt(i);
+    if (c >= 65 && c <= 90) c += 32;
+    result += String.fromCharCode(c);
+  }
+  return result;
+}
+
+function simpleUpper(s) {
+  var result = "";
+  for (var i = 0; i < s.length; i++) {
+    var c = s.charCodeAt(i);
+    if (c >= 97 && c <= 122) c -= 32;
+    result += String.fromCharCode(c);
+  }
+  return result;
+}
+
+// ASCII strings of all lengths up to a few words, starting at different
+// offsets into their buffer, and with the letters at the edges of the
+// ranges that change.
+var ascii = "@AZ[`az{ Hello, World! 0123456789 MiXeD cAsE @AZ[`az{";
+for (var start = 0; start < 9; start++) {
+  for (var end = start; end <= ascii.length; end++) {
+    var s = ascii.substring(start, end);
+    assertEquals(simpleLower(s), s.toLowerCase(), "lower " + s);
+    assertEquals(simpleUpper(s), s.toUpperCase(), "upper " + s);
+  }
+}
+
+// Strings that need no change are returned as they are.
+var lower = "no upper case letters here, 0123456789!";
+assertEquals(lower, lower.toLowerCase());
+var upper = "NO LOWER CASE LETTERS HERE, 0123456789!";
+assertEquals(upper, upper.toUpperCase());
+
+// Non-ASCII characters anywhere in the string use the full mapping.
+for (var i = 0; i < 20; i++) {
+  var prefix = "ABCDEFGHIJKLMNOPQRST".substring(0, i);
+  assertEquals(prefix.toLowerCase() + "éxyz",
+               (prefix + "ÉXYZ").toLowerCase());
+  assertEquals(prefix + "ÉXYZ",
+               (prefix.toLowerCase() + "éxyz").toUpperCase());
+  assertEquals(prefix + "Ÿ", (prefix.toLowerCase() + "ÿ").toUpperCase());
+  assertEquals(prefix.toLowerCase() + "αβ",
+               (prefix + "ΑΒ").toLowerCase());
+}
@@ -0,0 +1,87 @@
+// Copyright 2009 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Strings with characters in the range \u0080-ÿ are kept in the
+// one-byte representation.  Check that they behave like any other string.
+
+var cafe = "café";
+var CAFE = "CAFÉ";
+var two_byte_cafe = "caféĀ".substring(0, 4);
+
+assertEquals(4, cafe.length);
+assertEquals(0xe9, cafe.charCodeAt(3));
+assertEquals("é", cafe.charAt(3));
+assertTrue(cafe == two_byte_cafe);
+assertTrue(cafe == "caf" + String.fromCharCode(0xe9));
+assertEquals(cafe + "!", two_byte_cafe + "!");
+assertEquals("caféĀ", cafe + "Ā");
+assertTrue("é" < "Ā");
+assertTrue("é" > "z");
+
+// Searching across representations.
+assertEquals(3, ("Ā" + cafe).indexOf("fé"));
+assertEquals(1, "aébéc".indexOf("é"));
+assertEquals(3, "aébéc".lastIndexOf("é"));
+assertEquals(2, "xxéèyy".indexOf("éèy"));
+assertEquals(-1, cafe.indexOf("Ā"));
+assertEquals(-1, cafe.indexOf("ǩ"));
+
+// Case conversion, including characters whose upper case is outside
+// Latin-1 (ÿ -> Ÿ, µ -> Μ) or longer (ß -> SS).
+assertEquals(CAFE, cafe.toUpperCase());
+assertEquals(cafe, CAFE.toLowerCase());
+assertEquals("Ÿ", "ÿ".toUpperCase());
+assertEquals("Μ", "µ".toUpperCase());
+assertEquals("SS", "ß".toUpperCase());
+assertEquals("AŸSSΜ", "aÿßµ".toUpperCase());
+
+// Regular expressions on one-byte subjects.
+assertTrue(/é/.test(cafe));
+assertTrue(/É/i.test(cafe));
+assertTrue(/Ÿ/i.test("ÿ"));
+assertTrue(/Μ/i.test("µ"));
+assertTrue(/μ/i.test("µ"));
+assertFalse(/Ā/i.test(cafe));
+assertTrue(/(é)\1/i.test("éÉ"));
+assertFalse(/(÷)\1/i.test("÷×"));
+assertTrue(/^\s$/.test(" "));
+assertFalse(/^\S$/.test(" "));
+assertEquals("àÿé", /[à-ÿ]+/.exec("xyàÿéz")[0]);
+assertEquals("aééb", "aéb".replace(/é/g, "$&$&"));
+
+// Conversions.
+assertEquals(12, Number(" 12 "));
+assertTrue(isNaN(Number("1é")));
+assertEquals("%C3%A9", encodeURIComponent(cafe).substring(3));
+assertEquals(cafe, decodeURIComponent("caf%C3%A9"));
+assertEquals(cafe, unescape("caf%E9"));
+
+// Property names.
+var o = {};
+o[cafe] = 1;
+assertEquals(1, o[two_byte_cafe]);
+assertEquals(1, o["café"]);
@@ -162,6 +162,22 @@ replaceTest("0a1b2cx", short, /(x)(?=(.))/g, function r(m, c1, c2, i, s) {
 });
 assertEquals(3, ctr, "replace(/x/g,func) num-match");
 
+// The RegExp statics describe the current match while the function runs,
+// even if the function itself uses regexps.
+ctr = 0;
+replaceTest("0a1b2c3", short, /(x)/g, function r(m, c1, i, s) {
+  assertEquals("x", RegExp.$1, "replace(/(x)/g,func) RegExp.$1");
+  assertEquals(short.substring(0, i), RegExp.leftContext,
+               "replace(/(x)/g,func) RegExp.leftContext");
+  assertTrue(/(y)/.test("y"), "replace(/(x)/g,func) nested regexp");
+  return String(ctr++);
+});
+assertEquals(4, ctr, "replace(/(x)/g,func) num-match with nested regexp");
+
+replaceTest("[0]a[1]b[2]", "ab", /x*/g, function r(m, i) {
+  return "[" + i + "]";
+});
+
 
 // Test special cases of replacement parts longer than 1<<11.
 var longstring = "xyzzy";